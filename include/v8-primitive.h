@@ -479,6 +479,19 @@ class V8_EXPORT String : public Name {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalOneByte(
       Isolate* isolate, ExternalOneByteStringResource* resource);
 
+  /**
+   * Creates a new external one-byte string whose characters are a read-only
+   * memory mapping of the file at |path|, e.g. a large script, without copying
+   * them. The mapping is released when the string is no longer live on V8's
+   * heap. The file must not be modified while it is mapped.
+   *
+   * Returns an empty handle if the file cannot be mapped, is too long, or
+   * contains non-ASCII bytes. In the latter case the file should be read and
+   * decoded, e.g. with NewFromUtf8.
+   */
+  static V8_WARN_UNUSED_RESULT MaybeLocal<String> NewExternalOneByteFromFile(
+      Isolate* isolate, const char* path);
+
   /**
    * Associate an external string resource with this string by transforming it
    * in place so that existing references to this string in the JavaScript heap
@@ -48,6 +48,23 @@ class V8_EXPORT CompiledWasmModule {
    */
   OwnedBuffer Serialize();
 
+  /**
+   * Serialize the code of all functions that were optimized since the given
+   * |serialized| data was created, if that data was created by |Serialize| (and
+   * possibly already appended to) for this module. The result can be appended
+   * to |serialized| to update a cache entry incrementally. Returns an empty
+   * buffer if there is nothing to append or |serialized| does not match.
+   */
+  OwnedBuffer SerializeAppendedCode(MemorySpan<const uint8_t> serialized);
+
+  /**
+   * Serialize profile information of the module: which functions were
+   * executed and optimized so far, with their call counts and inlining
+   * feedback. Passing the profile to |WasmStreaming::SetProfileData| for a
+   * later compilation of the same module optimizes these functions early.
+   */
+  OwnedBuffer SerializeProfile();
+
   /**
    * Get the (wasm-encoded) wire bytes that were used to compile this module.
    */
@@ -111,6 +128,22 @@ class V8_EXPORT WasmModuleObject : public Object {
   static MaybeLocal<WasmModuleObject> Compile(
       Isolate* isolate, MemorySpan<const uint8_t> wire_bytes);
 
+  /**
+   * Re-create a WasmModuleObject, without recompiling, from the data in the
+   * file at |path|, which was created by |CompiledWasmModule::Serialize| (and
+   * possibly appended to via |CompiledWasmModule::SerializeAppendedCode|) for
+   * a module with the given |wire_bytes|. Returns an empty handle if the data
+   * cannot be used, e.g. because it was created by a different V8 version.
+   *
+   * With --wasm-lazy-deserialization, the file stays mapped until the code of
+   * all functions was deserialized on their first call, so processes loading
+   * the same file share its memory. While it is mapped, the file may be
+   * appended to or atomically replaced (e.g. by renaming another file over
+   * it), but must not be truncated or rewritten in place.
+   */
+  static MaybeLocal<WasmModuleObject> DeserializeFromFile(
+      Isolate* isolate, const char* path, MemorySpan<const uint8_t> wire_bytes);
+
   V8_INLINE static WasmModuleObject* Cast(Value* value) {
 #ifdef V8_ENABLE_CHECKS
     CheckCast(value);
@@ -187,6 +220,16 @@ class V8_EXPORT WasmStreaming final {
    */
   void SetUrl(const char* url, size_t length);
 
+  /**
+   * Passes profile data of a previous run of the module, created by
+   * |CompiledWasmModule::SerializeProfile|. The functions that were optimized
+   * in that run are compiled with the optimizing tier in the background,
+   * right after the module was compiled or deserialized. Invalid or
+   * mismatching data is ignored. The buffer is copied. This must be called
+   * before |Finish|.
+   */
+  void SetProfileData(const uint8_t* bytes, size_t size);
+
   /**
    * Unpacks a {WasmStreaming} object wrapped in a  {Managed} for the embedder.
    * Since the embedder is on the other side of the API, it cannot unpack the
@@ -127,6 +127,8 @@
 #include "src/snapshot/snapshot.h"
 #include "src/strings/char-predicates-inl.h"
 #include "src/strings/string-hasher.h"
+#include "src/strings/string-simd.h"
+#include "src/strings/unicode-decoder.h"
 #include "src/strings/unicode-inl.h"
 #include "src/tracing/trace-event.h"
 #include "src/utils/detachable-vector.h"
@@ -136,6 +138,7 @@
 #if V8_ENABLE_WEBASSEMBLY
 #include "src/debug/debug-wasm-objects.h"
 #include "src/trap-handler/trap-handler.h"
+#include "src/wasm/pgo.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/value-type.h"
 #include "src/wasm/wasm-engine.h"
@@ -5877,25 +5880,37 @@ static int WriteUtf8Impl(base::Vector<const Char> string, char* write_start,
     }
     // Write the characters to the stream.
     if (sizeof(Char) == 1) {
-      // Simply memcpy if we only have ASCII characters.
-      uint8_t char_mask = 0;
-      for (int i = read_index; i < up_to; i++) char_mask |= read_start[i];
-      if ((char_mask & 0x80) == 0) {
-        int copy_length = up_to - read_index;
+      while (read_index < up_to) {
+        // Simply memcpy runs of ASCII characters.
+        int copy_length = i::NonAsciiStart(
+            reinterpret_cast<const uint8_t*>(read_start + read_index),
+            up_to - read_index);
         memcpy(current_write, read_start + read_index, copy_length);
         current_write += copy_length;
-        read_index = up_to;
-      } else {
-        for (; read_index < up_to; read_index++) {
-          current_write += unibrow::Utf8::EncodeOneByte(
-              current_write, static_cast<uint8_t>(read_start[read_index]));
-          DCHECK(write_capacity == -1 ||
-                 (current_write - write_start) <= write_capacity);
-        }
+        read_index += copy_length;
+        if (read_index == up_to) break;
+        current_write += unibrow::Utf8::EncodeOneByte(
+            current_write, static_cast<uint8_t>(read_start[read_index++]));
+        DCHECK(write_capacity == -1 ||
+               (current_write - write_start) <= write_capacity);
       }
     } else {
-      for (; read_index < up_to; read_index++) {
-        uint16_t character = read_start[read_index];
+      while (read_index < up_to) {
+        // Narrow runs of ASCII characters in one go, unless they end right
+        // away, which is common in non-Latin text.
+        if (i::StringSimd::IsEnabledFor(up_to - read_index) &&
+            read_start[read_index] <= unibrow::Utf8::kMaxOneByteChar &&
+            read_start[read_index + 1] <= unibrow::Utf8::kMaxOneByteChar) {
+          int copy_length = static_cast<int>(i::StringSimd::NarrowAscii(
+              reinterpret_cast<uint8_t*>(current_write),
+              reinterpret_cast<const uint16_t*>(read_start + read_index),
+              up_to - read_index));
+          current_write += copy_length;
+          read_index += copy_length;
+          prev_char = read_start[read_index - 1];
+          if (read_index == up_to) break;
+        }
+        uint16_t character = read_start[read_index++];
         current_write += unibrow::Utf8::Encode(current_write, character,
                                                prev_char, replace_invalid_utf8);
         prev_char = character;
@@ -7644,6 +7659,47 @@ MaybeLocal<String> v8::String::NewExternalOneByte(
   return Utils::ToLocal(string);
 }
 
+namespace {
+
+// Owns the mapping of a file, which is unmapped when the external string is
+// finalized and disposes of its resource.
+class MappedFileOneByteStringResource final
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit MappedFileOneByteStringResource(
+      std::unique_ptr<base::OS::MemoryMappedFile> file)
+      : file_(std::move(file)) {}
+
+  const char* data() const override {
+    return static_cast<const char*>(file_->memory());
+  }
+  size_t length() const override { return file_->size(); }
+
+ private:
+  const std::unique_ptr<base::OS::MemoryMappedFile> file_;
+};
+
+}  // namespace
+
+MaybeLocal<String> v8::String::NewExternalOneByteFromFile(Isolate* v8_isolate,
+                                                          const char* path) {
+  CHECK_NOT_NULL(path);
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(
+          path, base::OS::MemoryMappedFile::FileMode::kReadOnly));
+  if (!file || file->size() > static_cast<size_t>(i::String::kMaxLength)) {
+    return MaybeLocal<String>();
+  }
+  // One-byte strings are Latin-1, so only ASCII files have the same characters
+  // as when they are decoded as UTF-8.
+  if (!i::String::IsAscii(static_cast<const char*>(file->memory()),
+                          static_cast<int>(file->size()))) {
+    return MaybeLocal<String>();
+  }
+  return NewExternalOneByte(
+      v8_isolate, new MappedFileOneByteStringResource(std::move(file)));
+}
+
 bool v8::String::MakeExternal(v8::String::ExternalStringResource* resource) {
   i::DisallowGarbageCollection no_gc;
 
@@ -8801,6 +8857,39 @@ OwnedBuffer CompiledWasmModule::Serialize() {
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+OwnedBuffer CompiledWasmModule::SerializeAppendedCode(
+    MemorySpan<const uint8_t> serialized) {
+#if V8_ENABLE_WEBASSEMBLY
+  TRACE_EVENT0("v8.wasm", "wasm.SerializeAppendedCode");
+  i::wasm::WasmSerializer wasm_serializer(native_module_.get());
+  base::Vector<const uint8_t> serialized_vec{serialized.data(),
+                                             serialized.size()};
+  size_t buffer_size = wasm_serializer.GetAppendedCodeSize(serialized_vec);
+  if (buffer_size == 0) return {};
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+  if (!wasm_serializer.SerializeAppendedCode(serialized_vec,
+                                             {buffer.get(), buffer_size})) {
+    return {};
+  }
+  return {std::move(buffer), buffer_size};
+#else
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
+OwnedBuffer CompiledWasmModule::SerializeProfile() {
+#if V8_ENABLE_WEBASSEMBLY
+  TRACE_EVENT0("v8.wasm", "wasm.SerializeProfile");
+  base::OwnedVector<uint8_t> profile_data = i::wasm::GetProfileData(
+      native_module_->module(), native_module_->wire_bytes(),
+      native_module_->tiering_budget_array());
+  size_t size = profile_data.size();
+  return {profile_data.ReleaseData(), size};
+#else
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 MemorySpan<const uint8_t> CompiledWasmModule::GetWireBytesRef() {
 #if V8_ENABLE_WEBASSEMBLY
   base::Vector<const uint8_t> bytes_vec = native_module_->wire_bytes();
@@ -8881,6 +8970,27 @@ MaybeLocal<WasmModuleObject> WasmModuleObject::Compile(
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+MaybeLocal<WasmModuleObject> WasmModuleObject::DeserializeFromFile(
+    Isolate* v8_isolate, const char* path,
+    MemorySpan<const uint8_t> wire_bytes) {
+#if V8_ENABLE_WEBASSEMBLY
+  TRACE_EVENT0("v8.wasm", "wasm.DeserializeModuleFromFile");
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  i::Handle<i::WasmModuleObject> module_object;
+  if (!i::wasm::DeserializeNativeModuleFromFile(
+           i_isolate, path, {wire_bytes.data(), wire_bytes.size()},
+           i::wasm::CompileTimeImports{}, {})
+           .ToHandle(&module_object)) {
+    return MaybeLocal<WasmModuleObject>();
+  }
+  return Utils::ToLocal(module_object);
+#else
+  Utils::ApiCheck(false, "WasmModuleObject::DeserializeFromFile",
+                  "WebAssembly support is not enabled");
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 void* v8::ArrayBuffer::Allocator::Reallocate(void* data, size_t old_length,
                                              size_t new_length) {
   if (old_length == new_length) return data;
@@ -11629,6 +11739,10 @@ void WasmStreaming::SetMoreFunctionsCanBeSerializedCallback(
   UNREACHABLE();
 }
 
+void WasmStreaming::SetProfileData(const uint8_t* bytes, size_t size) {
+  UNREACHABLE();
+}
+
 void WasmStreaming::SetUrl(const char* url, size_t length) { UNREACHABLE(); }
 
 // static
@@ -398,6 +398,50 @@ void RegExpBuiltinsAssembler::GetStringPointers(
   *var_string_end = ReinterpretCast<RawPtrT>(IntPtrAdd(string_data, to_offset));
 }
 
+void RegExpBuiltinsAssembler::SkipToLiteralPrefix(
+    TNode<FixedArray> data, TNode<RawPtrT> string_data, TNode<IntPtrT> offset,
+    TNode<IntPtrT> string_length, String::Encoding encoding,
+    TVariable<IntPtrT>* var_last_index, Label* if_not_found) {
+  Label out(this);
+  TNode<Object> literal_prefix =
+      UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpLiteralPrefixIndex);
+  GotoIf(TaggedIsSmi(literal_prefix), &out);
+
+  TNode<String> prefix = CAST(literal_prefix);
+  CSA_DCHECK(this, IsSeqOneByteString(prefix));
+  TNode<RawPtrT> prefix_data = RawPtrAdd(
+      ReinterpretCast<RawPtrT>(BitcastTaggedToWord(prefix)),
+      IntPtrConstant(OFFSET_OF_DATA_START(SeqOneByteString) - kHeapObjectTag));
+  TNode<IntPtrT> prefix_length = LoadStringLengthAsWord(prefix);
+
+  const ElementsKind kind = (encoding == String::ONE_BYTE_ENCODING)
+                                ? UINT8_ELEMENTS
+                                : UINT16_ELEMENTS;
+  TNode<RawPtrT> subject_data =
+      RawPtrAdd(string_data, ElementOffsetFromIndex(offset, kind));
+  TNode<ExternalReference> function_addr = ExternalConstant(
+      encoding == String::ONE_BYTE_ENCODING
+          ? ExternalReference::search_string_raw_one_one()
+          : ExternalReference::search_string_raw_two_one());
+  TNode<ExternalReference> isolate_ptr =
+      ExternalConstant(ExternalReference::isolate_address(isolate()));
+
+  MachineType type_ptr = MachineType::Pointer();
+  MachineType type_intptr = MachineType::IntPtr();
+  TNode<IntPtrT> index = UncheckedCast<IntPtrT>(CallCFunction(
+      function_addr, type_intptr, std::make_pair(type_ptr, isolate_ptr),
+      std::make_pair(type_ptr, subject_data),
+      std::make_pair(type_intptr, string_length),
+      std::make_pair(type_ptr, prefix_data),
+      std::make_pair(type_intptr, prefix_length),
+      std::make_pair(type_intptr, var_last_index->value())));
+  GotoIf(IntPtrLessThan(index, IntPtrConstant(0)), if_not_found);
+  *var_last_index = index;
+  Goto(&out);
+
+  BIND(&out);
+}
+
 TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
     TNode<Context> context, TNode<JSRegExp> regexp, TNode<String> string,
     TNode<Number> last_index, TNode<RegExpMatchInfo> match_info,
@@ -429,6 +473,7 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
   TNode<IntPtrT> int_last_index = PositiveSmiUntag(CAST(last_index));
 
   GotoIf(UintPtrGreaterThan(int_last_index, int_string_length), &if_failure);
+  TVARIABLE(IntPtrT, var_last_index, int_last_index);
 
   // Since the RegExp has been compiled, data contains a fixed array.
   TNode<FixedArray> data = CAST(LoadObjectField(regexp, JSRegExp::kDataOffset));
@@ -487,9 +532,13 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     BIND(&if_isonebyte);
     {
-      GetStringPointers(direct_string_data, to_direct.offset(), int_last_index,
-                        int_string_length, String::ONE_BYTE_ENCODING,
-                        &var_string_start, &var_string_end);
+      SkipToLiteralPrefix(data, direct_string_data, to_direct.offset(),
+                          int_string_length, String::ONE_BYTE_ENCODING,
+                          &var_last_index, &if_failure);
+      GetStringPointers(direct_string_data, to_direct.offset(),
+                        var_last_index.value(), int_string_length,
+                        String::ONE_BYTE_ENCODING, &var_string_start,
+                        &var_string_end);
       var_code =
           UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpLatin1CodeIndex);
       var_bytecode = UnsafeLoadFixedArrayElement(
@@ -499,9 +548,13 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     BIND(&if_istwobyte);
     {
-      GetStringPointers(direct_string_data, to_direct.offset(), int_last_index,
-                        int_string_length, String::TWO_BYTE_ENCODING,
-                        &var_string_start, &var_string_end);
+      SkipToLiteralPrefix(data, direct_string_data, to_direct.offset(),
+                          int_string_length, String::TWO_BYTE_ENCODING,
+                          &var_last_index, &if_failure);
+      GetStringPointers(direct_string_data, to_direct.offset(),
+                        var_last_index.value(), int_string_length,
+                        String::TWO_BYTE_ENCODING, &var_string_start,
+                        &var_string_end);
       var_code =
           UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpUC16CodeIndex);
       var_bytecode = UnsafeLoadFixedArrayElement(
@@ -550,7 +603,7 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     // Argument 1: Previous index.
     MachineType arg1_type = type_int32;
-    TNode<Int32T> arg1 = TruncateIntPtrToInt32(int_last_index);
+    TNode<Int32T> arg1 = TruncateIntPtrToInt32(var_last_index.value());
 
     // Argument 2: Start of string data. This argument is ignored in the
     // interpreter.
@@ -50,6 +50,15 @@ class RegExpBuiltinsAssembler : public CodeStubAssembler {
                          TVariable<RawPtrT>* var_string_start,
                          TVariable<RawPtrT>* var_string_end);
 
+  // Advances {var_last_index} to the first occurrence of the literal prefix
+  // of the regexp with the given {data}, if it has one. Jumps to
+  // {if_not_found} if the prefix doesn't occur in the rest of the string.
+  void SkipToLiteralPrefix(TNode<FixedArray> data, TNode<RawPtrT> string_data,
+                           TNode<IntPtrT> offset, TNode<IntPtrT> string_length,
+                           String::Encoding encoding,
+                           TVariable<IntPtrT>* var_last_index,
+                           Label* if_not_found);
+
   // Low level logic around the actual call into pattern matching code.
   TNode<HeapObject> RegExpExecInternal(
       TNode<Context> context, TNode<JSRegExp> regexp, TNode<String> string,
@@ -1195,7 +1195,11 @@ RegisterAllocationData::RegisterAllocationData(
       spill_state_(code->InstructionBlockCount(), ZoneVector<LiveRange*>(zone),
                    zone),
       tick_counter_(tick_counter),
-      slot_for_const_range_(zone) {
+      slot_for_const_range_(zone),
+      use_fast_allocation_(
+          v8_flags.turbo_fast_register_allocation_threshold > 0 &&
+          code->LastInstructionIndex() + 1 >=
+              v8_flags.turbo_fast_register_allocation_threshold) {
   if (kFPAliasing == AliasingKind::kCombine) {
     fixed_float_live_ranges_.resize(
         kNumberOfFixedRangesPerRegister * this->config()->num_float_registers(),
@@ -2797,7 +2801,7 @@ LifetimePosition RegisterAllocator::FindOptimalSplitPos(LifetimePosition start,
 
   const InstructionBlock* block = end_block;
   // Find header of outermost loop.
-  do {
+  while (!data()->use_fast_allocation()) {
     const InstructionBlock* loop = GetContainingLoop(code(), block);
     if (loop == nullptr ||
         loop->rpo_number().ToInt() <= start_block->rpo_number().ToInt()) {
@@ -2805,7 +2809,7 @@ LifetimePosition RegisterAllocator::FindOptimalSplitPos(LifetimePosition start,
       break;
     }
     block = loop;
-  } while (true);
+  }
 
   // We did not find any suitable outer loop. Split at the latest possible
   // position unless end_block is a loop header itself.
@@ -2822,6 +2826,9 @@ LifetimePosition RegisterAllocator::FindOptimalSpillingPos(
   // TODO(herhut): Be more clever here as long as we do not move pos out of
   // deferred code.
   if (spill_mode == SpillMode::kSpillDeferred) return pos;
+  // Hoisting spills out of loops requires scanning the uses of the range
+  // within the loop, which is too slow for very large functions.
+  if (data()->use_fast_allocation()) return pos;
   const InstructionBlock* block = GetInstructionBlock(code(), pos.Start());
   const InstructionBlock* loop_header =
       block->IsLoopHeader() ? block : GetContainingLoop(code(), block);
@@ -4442,6 +4449,8 @@ void LinearScanAllocator::SplitAndSpillIntersecting(LiveRange* current,
 
 bool LinearScanAllocator::TryReuseSpillForPhi(TopLevelLiveRange* range) {
   if (!range->is_phi()) return false;
+  // Without bundles, the inputs of the phi don't share its spill range.
+  if (data()->use_fast_allocation()) return false;
 
   DCHECK(!range->HasSpillOperand());
   // Check how many operands belong to the same bundle as the output.
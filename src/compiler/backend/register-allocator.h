@@ -340,6 +340,12 @@ class RegisterAllocationData final : public ZoneObject {
     return slot_for_const_range_;
   }
 
+  // For very large functions (see --turbo-fast-register-allocation-threshold),
+  // the allocator skips its more expensive heuristics (live range bundles,
+  // loop-aware split and spill positions, spill slot reuse for phis and move
+  // optimization), which produces more moves but bounds compile time.
+  bool use_fast_allocation() const { return use_fast_allocation_; }
+
  private:
   Zone* const allocation_zone_;
   Frame* const frame_;
@@ -366,6 +372,7 @@ class RegisterAllocationData final : public ZoneObject {
   ZoneVector<ZoneVector<LiveRange*>> spill_state_;
   TickCounter* const tick_counter_;
   ZoneMap<TopLevelLiveRange*, AllocatedOperand*> slot_for_const_range_;
+  const bool use_fast_allocation_;
 };
 
 // Representation of the non-empty interval [start,end[.
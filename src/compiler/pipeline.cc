@@ -4154,7 +4154,11 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   Run<MeetRegisterConstraintsPhase>();
   Run<ResolvePhisPhase>();
   Run<BuildLiveRangesPhase>();
-  Run<BuildBundlesPhase>();
+  bool use_fast_allocation =
+      data->register_allocation_data()->use_fast_allocation();
+  if (!use_fast_allocation) {
+    Run<BuildBundlesPhase>();
+  }
 
   TraceSequence(info(), data, "before register allocation");
   if (verifier != nullptr) {
@@ -4197,7 +4201,7 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
 
   Run<PopulateReferenceMapsPhase>();
 
-  if (v8_flags.turbo_move_optimization) {
+  if (v8_flags.turbo_move_optimization && !use_fast_allocation) {
     Run<OptimizeMovesPhase>();
   }
 
@@ -155,6 +155,34 @@ class GraphVisitor : public OutputGraphAssembler<GraphVisitor<AfterNext>,
 
   const Block* current_input_block() { return current_input_block_; }
 
+  // Records that {old_index} has been replaced by {new_index}. This is public
+  // for reducers that emit the replacement of an operation before visiting it
+  // (or at a different place than where it is in the input graph).
+  void CreateOldToNewMapping(OpIndex old_index, OpIndex new_index) {
+    DCHECK(old_index.valid());
+    DCHECK(Asm().input_graph().BelongsToThisGraph(old_index));
+    DCHECK_IMPLIES(new_index.valid(),
+                   Asm().output_graph().BelongsToThisGraph(new_index));
+
+    if (current_block_needs_variables_) {
+      MaybeVariable var = GetVariableFor(old_index);
+      if (!var.has_value()) {
+        MaybeRegisterRepresentation rep =
+            Asm().input_graph().Get(old_index).outputs_rep().size() == 1
+                ? static_cast<const MaybeRegisterRepresentation&>(
+                      Asm().input_graph().Get(old_index).outputs_rep()[0])
+                : MaybeRegisterRepresentation::None();
+        var = Asm().NewLoopInvariantVariable(rep);
+        SetVariableFor(old_index, *var);
+      }
+      Asm().SetVariable(*var, new_index);
+      return;
+    }
+
+    DCHECK(!op_mapping_[old_index].valid());
+    op_mapping_[old_index] = new_index;
+  }
+
   bool* turn_loop_without_backedge_into_merge() {
     return &turn_loop_without_backedge_into_merge_;
   }
@@ -905,31 +933,6 @@ class GraphVisitor : public OutputGraphAssembler<GraphVisitor<AfterNext>,
     return V<None>::Invalid();
   }
 
-  void CreateOldToNewMapping(OpIndex old_index, OpIndex new_index) {
-    DCHECK(old_index.valid());
-    DCHECK(Asm().input_graph().BelongsToThisGraph(old_index));
-    DCHECK_IMPLIES(new_index.valid(),
-                   Asm().output_graph().BelongsToThisGraph(new_index));
-
-    if (current_block_needs_variables_) {
-      MaybeVariable var = GetVariableFor(old_index);
-      if (!var.has_value()) {
-        MaybeRegisterRepresentation rep =
-            Asm().input_graph().Get(old_index).outputs_rep().size() == 1
-                ? static_cast<const MaybeRegisterRepresentation&>(
-                      Asm().input_graph().Get(old_index).outputs_rep()[0])
-                : MaybeRegisterRepresentation::None();
-        var = Asm().NewLoopInvariantVariable(rep);
-        SetVariableFor(old_index, *var);
-      }
-      Asm().SetVariable(*var, new_index);
-      return;
-    }
-
-    DCHECK(!op_mapping_[old_index].valid());
-    op_mapping_[old_index] = new_index;
-  }
-
   MaybeVariable GetVariableFor(OpIndex old_index) const {
     return old_opindex_to_variables[old_index];
   }
@@ -0,0 +1,287 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-bounds-check-elimination-reducer.h"
+
+#include "src/compiler/turboshaft/loop-finder.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void LoopBoundsCheckEliminationAnalyzer::Run() {
+  LoopFinder loop_finder(phase_zone_, &graph_);
+  if (loop_finder.LoopHeaders().empty()) return;
+  FindOverflowDeoptimizingBinops();
+  ComputeInductionVariableBounds(loop_finder);
+  if (induction_variable_bounds_.empty()) return;
+  FindRedundantChecks();
+}
+
+// Records the overflow-checked binops whose overflow projection is the
+// condition of a DeoptimizeIf in the same block. Since the binop's value can
+// only be used after its block, it is never used when it has wrapped around.
+void LoopBoundsCheckEliminationAnalyzer::FindOverflowDeoptimizingBinops() {
+  for (const Block& block : graph_.blocks()) {
+    for (OpIndex op_idx : graph_.OperationIndices(block)) {
+      const DeoptimizeIfOp* deopt =
+          graph_.Get(op_idx).TryCast<DeoptimizeIfOp>();
+      if (!deopt || deopt->negated) continue;
+      const ProjectionOp* proj =
+          matcher_.TryCast<ProjectionOp>(deopt->condition());
+      if (!proj || proj->index != OverflowCheckedBinopOp::kOverflowIndex) {
+        continue;
+      }
+      if (!matcher_.Is<OverflowCheckedBinopOp>(proj->input())) continue;
+      if (!block.Contains(proj->input())) continue;
+      overflow_deoptimizing_binops_.insert(proj->input());
+    }
+  }
+}
+
+void LoopBoundsCheckEliminationAnalyzer::ComputeInductionVariableBounds(
+    const LoopFinder& loop_finder) {
+  for (const auto& [header, info] : loop_finder.LoopHeaders()) {
+    const BranchOp* branch =
+        header->LastOperation(graph_).TryCast<BranchOp>();
+    if (!branch) continue;
+
+    // Exactly one of the successors of the header should be in the loop, so
+    // that the Branch is the one that decides whether to exit the loop or
+    // not.
+    const Block* if_true_header = loop_finder.GetLoopHeader(branch->if_true);
+    const Block* if_false_header = loop_finder.GetLoopHeader(branch->if_false);
+    if (if_true_header == if_false_header) continue;
+    bool loop_if_cond_is = if_true_header == header;
+    const Block* body_entry =
+        loop_if_cond_is ? branch->if_true : branch->if_false;
+    // If the in-loop successor has other predecessors, it doesn't only
+    // execute when the loop condition holds.
+    if (body_entry->PredecessorCount() != 1) continue;
+
+    OpIndex index, limit;
+    WordRepresentation rep;
+    bool is_signed;
+    if (!MatchLoopCondition(header, branch->condition(), loop_if_cond_is,
+                            &index, &limit, &rep, &is_signed)) {
+      continue;
+    }
+    induction_variable_bounds_.push_back(
+        {body_entry, index, limit, rep, is_signed});
+  }
+}
+
+// Tries to match a loop condition that ensures that the loop body only
+// executes when `index <ᵘ limit`. If the condition is a signed comparison,
+// this requires {index} to be a non-negative induction variable of {header}.
+bool LoopBoundsCheckEliminationAnalyzer::MatchLoopCondition(
+    const Block* header, OpIndex cond_idx, bool loop_if_cond_is,
+    OpIndex* index, OpIndex* limit, WordRepresentation* rep,
+    bool* is_signed) const {
+  const ComparisonOp* cmp = matcher_.TryCast<ComparisonOp>(cond_idx);
+  if (!cmp) return false;
+  if (cmp->rep != RegisterRepresentation::Word32() &&
+      cmp->rep != RegisterRepresentation::Word64()) {
+    return false;
+  }
+  *rep = WordRepresentation(cmp->rep);
+
+  if (loop_if_cond_is) {
+    // We loop when `index < limit`.
+    switch (cmp->kind) {
+      case ComparisonOp::Kind::kSignedLessThan:
+        *is_signed = true;
+        break;
+      case ComparisonOp::Kind::kUnsignedLessThan:
+        *is_signed = false;
+        break;
+      default:
+        return false;
+    }
+    *index = cmp->left();
+    *limit = cmp->right();
+  } else {
+    // We exit when `limit <= index`, which means that we loop when
+    // `index < limit`.
+    switch (cmp->kind) {
+      case ComparisonOp::Kind::kSignedLessThanOrEqual:
+        *is_signed = true;
+        break;
+      case ComparisonOp::Kind::kUnsignedLessThanOrEqual:
+        *is_signed = false;
+        break;
+      default:
+        return false;
+    }
+    *index = cmp->right();
+    *limit = cmp->left();
+  }
+
+  if (!*is_signed) {
+    // `index <ᵘ limit` is exactly what a bounds check verifies.
+    return true;
+  }
+  return IsNonNegativeInductionVariable(header, *index, *rep);
+}
+
+// Returns true if {phi_idx} is a loop phi of {header} of the form
+// `phi(init, phi + increment)` with `init >= 0` and `increment > 0`, and for
+// which the increment cannot wrap around, assuming that the loop condition
+// `phi <ˢ limit` holds before the increment.
+bool LoopBoundsCheckEliminationAnalyzer::IsNonNegativeInductionVariable(
+    const Block* header, OpIndex phi_idx, WordRepresentation rep) const {
+  if (!matcher_.MatchPhi(phi_idx, 2)) return false;
+  if (!header->Contains(phi_idx)) return false;
+  const PhiOp& phi = matcher_.Cast<PhiOp>(phi_idx);
+  if (phi.rep != static_cast<RegisterRepresentation>(rep)) return false;
+
+  int64_t init;
+  if (!matcher_.MatchIntegralWordConstant(phi.input(0), rep, &init) ||
+      init < 0) {
+    return false;
+  }
+
+  int64_t increment;
+  bool overflow_checked;
+  if (!MatchIncrement(phi.input(PhiOp::kLoopPhiBackEdgeIndex), phi_idx, rep,
+                      &increment, &overflow_checked)) {
+    return false;
+  }
+  if (increment <= 0) return false;
+  // Since `phi <ˢ limit <= kMaxInt`, `phi + 1` cannot overflow. Larger
+  // increments could however wrap around, unless overflows deoptimize.
+  return overflow_checked || increment == 1;
+}
+
+bool LoopBoundsCheckEliminationAnalyzer::MatchIncrement(
+    OpIndex idx, OpIndex phi_idx, WordRepresentation rep, int64_t* increment,
+    bool* overflow_checked) const {
+  OpIndex left, right;
+  if (const WordBinopOp* binop = matcher_.TryCast<WordBinopOp>(idx)) {
+    if (binop->kind != WordBinopOp::Kind::kAdd || binop->rep != rep) {
+      return false;
+    }
+    left = binop->left();
+    right = binop->right();
+    *overflow_checked = false;
+  } else if (const ProjectionOp* proj = matcher_.TryCast<ProjectionOp>(idx)) {
+    if (proj->index != OverflowCheckedBinopOp::kValueIndex) return false;
+    const OverflowCheckedBinopOp* binop =
+        matcher_.TryCast<OverflowCheckedBinopOp>(proj->input());
+    if (!binop || binop->kind != OverflowCheckedBinopOp::Kind::kSignedAdd ||
+        binop->rep != rep) {
+      return false;
+    }
+    // The overflow bit only makes the increment monotonic if it deopts.
+    if (!overflow_deoptimizing_binops_.contains(proj->input())) return false;
+    left = binop->left();
+    right = binop->right();
+    *overflow_checked = true;
+  } else {
+    return false;
+  }
+
+  if (left == phi_idx) {
+    return matcher_.MatchIntegralWordConstant(right, rep, increment);
+  } else if (right == phi_idx) {
+    return matcher_.MatchIntegralWordConstant(left, rep, increment);
+  }
+  return false;
+}
+
+void LoopBoundsCheckEliminationAnalyzer::FindRedundantChecks() {
+  for (const Block& block : graph_.blocks()) {
+    for (OpIndex op_idx : graph_.OperationIndices(block)) {
+      const DeoptimizeIfOp* deopt =
+          graph_.Get(op_idx).TryCast<DeoptimizeIfOp>();
+      if (!deopt) continue;
+      OpIndex index, limit;
+      WordRepresentation rep;
+      if (!MatchBoundsCheck(*deopt, &index, &limit, &rep)) continue;
+      if (IsProvenInBounds(&block, index, limit, rep)) {
+        redundant_checks_.insert(op_idx);
+      }
+    }
+  }
+}
+
+// Matches `DeoptimizeIfNot(index <ᵘ limit)` and
+// `DeoptimizeIf(limit <=ᵘ index)`.
+bool LoopBoundsCheckEliminationAnalyzer::MatchBoundsCheck(
+    const DeoptimizeIfOp& deopt, OpIndex* index, OpIndex* limit,
+    WordRepresentation* rep) const {
+  const ComparisonOp* cmp = matcher_.TryCast<ComparisonOp>(deopt.condition());
+  if (!cmp) return false;
+  if (cmp->rep != RegisterRepresentation::Word32() &&
+      cmp->rep != RegisterRepresentation::Word64()) {
+    return false;
+  }
+  *rep = WordRepresentation(cmp->rep);
+  if (deopt.negated && cmp->kind == ComparisonOp::Kind::kUnsignedLessThan) {
+    *index = cmp->left();
+    *limit = cmp->right();
+    return true;
+  }
+  if (!deopt.negated &&
+      cmp->kind == ComparisonOp::Kind::kUnsignedLessThanOrEqual) {
+    *index = cmp->right();
+    *limit = cmp->left();
+    return true;
+  }
+  return false;
+}
+
+// Matches a Word32 to Word64 extension of {idx}. Sign-extensions are only
+// matched if {input_is_non_negative}, since they would otherwise turn small
+// unsigned values into large ones.
+bool LoopBoundsCheckEliminationAnalyzer::MatchWord32ToWord64Extension(
+    OpIndex idx, OpIndex* input, bool input_is_non_negative) const {
+  if (matcher_.MatchChange(idx, input, ChangeOp::Kind::kZeroExtend,
+                           RegisterRepresentation::Word32(),
+                           RegisterRepresentation::Word64())) {
+    return true;
+  }
+  return input_is_non_negative &&
+         matcher_.MatchChange(idx, input, ChangeOp::Kind::kSignExtend,
+                              RegisterRepresentation::Word32(),
+                              RegisterRepresentation::Word64());
+}
+
+bool LoopBoundsCheckEliminationAnalyzer::IsProvenInBounds(
+    const Block* block, OpIndex index, OpIndex limit,
+    WordRepresentation rep) const {
+  for (const InductionVariableBound& bound : induction_variable_bounds_) {
+    OpIndex check_index = index;
+    OpIndex check_limit = limit;
+    if (rep != bound.rep) {
+      // 64-bit checks of 32-bit induction variables (for instance for typed
+      // arrays, whose length is a word64). Extending both values preserves
+      // the comparison, and so does truncating the 64-bit limit of the loop
+      // condition, since this can only make it smaller (as an unsigned
+      // value).
+      if (rep != WordRepresentation::Word64() ||
+          bound.rep != WordRepresentation::Word32()) {
+        continue;
+      }
+      if (!MatchWord32ToWord64Extension(index, &check_index,
+                                        bound.is_signed)) {
+        continue;
+      }
+      OpIndex truncated_limit;
+      if (matcher_.MatchChange(bound.limit, &truncated_limit,
+                               ChangeOp::Kind::kTruncate,
+                               RegisterRepresentation::Word64(),
+                               RegisterRepresentation::Word32()) &&
+          truncated_limit == limit) {
+        check_limit = bound.limit;
+      } else if (!MatchWord32ToWord64Extension(limit, &check_limit,
+                                               bound.is_signed)) {
+        continue;
+      }
+    }
+    if (check_index != bound.index || check_limit != bound.limit) continue;
+    if (block->IsDominatedBy(bound.body_entry)) return true;
+  }
+  return false;
+}
+
+}  // namespace v8::internal::compiler::turboshaft
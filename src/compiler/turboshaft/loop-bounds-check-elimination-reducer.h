@@ -0,0 +1,131 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_BOUNDS_CHECK_ELIMINATION_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_BOUNDS_CHECK_ELIMINATION_REDUCER_H_
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operation-matcher.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// LoopBoundsCheckElimination removes bounds checks on induction variables of
+// loops whose exit condition already proves that the check cannot fail. In
+// particular, it recognizes loops like
+//
+//    for (let i = 0; i < a.length; i++) { ... a[i] ... }
+//
+// where the loop header contains a phi `i = phi(init, i + c)` with a
+// non-negative `init`, and where the loop is only entered when
+// `i < length` holds. In every block dominated by the in-loop successor of
+// the header, we then know that `0 <= i < length`, which means that a check
+// `DeoptimizeIfNot(Uint32LessThan(i, length))` is redundant.
+//
+// Overflow of the increment has to be excluded for the reasoning above to
+// hold: an overflow-checked addition is fine if its overflow bit feeds a
+// DeoptimizeIf, and a wrapping addition of 1 cannot overflow since
+// `i < length <= kMaxInt`.
+//
+// Note that the limit of the check has to be the same operation as the limit
+// of the loop condition, but doesn't need to be loop invariant: the condition
+// is re-evaluated at each iteration, and both operations see the same value.
+
+class V8_EXPORT_PRIVATE LoopBoundsCheckEliminationAnalyzer {
+ public:
+  LoopBoundsCheckEliminationAnalyzer(Zone* phase_zone, Graph& input_graph)
+      : phase_zone_(phase_zone),
+        graph_(input_graph),
+        matcher_(input_graph),
+        overflow_deoptimizing_binops_(phase_zone),
+        induction_variable_bounds_(phase_zone),
+        redundant_checks_(phase_zone) {}
+
+  void Run();
+
+  bool IsRedundantCheck(OpIndex deopt_if) const {
+    return redundant_checks_.contains(deopt_if);
+  }
+  size_t redundant_check_count() const { return redundant_checks_.size(); }
+
+ private:
+  // Records that in all of the blocks dominated by {body_entry}, `{index} <ᵘ
+  // {limit}` holds (for the representation {rep}). If {is_signed}, then
+  // `0 <= {index} <ˢ {limit}` holds as well.
+  struct InductionVariableBound {
+    const Block* body_entry;
+    OpIndex index;
+    OpIndex limit;
+    WordRepresentation rep;
+    bool is_signed;
+  };
+
+  void FindOverflowDeoptimizingBinops();
+  void ComputeInductionVariableBounds(const LoopFinder& loop_finder);
+  void FindRedundantChecks();
+
+  bool MatchLoopCondition(const Block* header, OpIndex cond_idx,
+                          bool loop_if_cond_is, OpIndex* index,
+                          OpIndex* limit, WordRepresentation* rep,
+                          bool* is_signed) const;
+  bool IsNonNegativeInductionVariable(const Block* header, OpIndex phi_idx,
+                                      WordRepresentation rep) const;
+  bool MatchIncrement(OpIndex idx, OpIndex phi_idx, WordRepresentation rep,
+                      int64_t* increment, bool* overflow_checked) const;
+  bool MatchWord32ToWord64Extension(OpIndex idx, OpIndex* input,
+                                    bool input_is_non_negative) const;
+  bool IsProvenInBounds(const Block* block, OpIndex index, OpIndex limit,
+                        WordRepresentation rep) const;
+  bool MatchBoundsCheck(const DeoptimizeIfOp& deopt, OpIndex* index,
+                        OpIndex* limit, WordRepresentation* rep) const;
+
+  Zone* phase_zone_;
+  Graph& graph_;
+  const OperationMatcher matcher_;
+
+  // The OverflowCheckedBinops of the input graph that deopt on overflow.
+  ZoneAbslFlatHashSet<OpIndex> overflow_deoptimizing_binops_;
+  ZoneVector<InductionVariableBound> induction_variable_bounds_;
+  // The DeoptimizeIf operations of the input graph that can be removed.
+  ZoneAbslFlatHashSet<OpIndex> redundant_checks_;
+};
+
+template <class Next>
+class LoopBoundsCheckEliminationReducer : public Next {
+ public:
+  TURBOSHAFT_REDUCER_BOILERPLATE(LoopBoundsCheckElimination)
+
+  void Analyze() {
+    if (v8_flags.turboshaft_loop_bounds_check_elimination) {
+      analyzer_.Run();
+    }
+    Next::Analyze();
+  }
+
+  V<None> REDUCE_INPUT_GRAPH(DeoptimizeIf)(V<None> ig_index,
+                                           const DeoptimizeIfOp& deopt) {
+    LABEL_BLOCK(no_change) {
+      return Next::ReduceInputGraphDeoptimizeIf(ig_index, deopt);
+    }
+    if (ShouldSkipOptimizationStep()) goto no_change;
+
+    if (analyzer_.IsRedundantCheck(ig_index)) {
+      // The loop condition guarantees that this check never fails.
+      return V<None>::Invalid();
+    }
+    goto no_change;
+  }
+
+ private:
+  LoopBoundsCheckEliminationAnalyzer analyzer_{Asm().phase_zone(),
+                                               Asm().modifiable_input_graph()};
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_BOUNDS_CHECK_ELIMINATION_REDUCER_H_
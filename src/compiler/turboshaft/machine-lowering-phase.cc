@@ -8,8 +8,10 @@
 #include "src/compiler/turboshaft/dataview-lowering-reducer.h"
 #include "src/compiler/turboshaft/fast-api-call-lowering-reducer.h"
 #include "src/compiler/turboshaft/js-generic-lowering-reducer.h"
+#include "src/compiler/turboshaft/loop-bounds-check-elimination-reducer.h"
 #include "src/compiler/turboshaft/machine-lowering-reducer-inl.h"
 #include "src/compiler/turboshaft/machine-optimization-reducer.h"
+#include "src/compiler/turboshaft/partial-escape-analysis-reducer.h"
 #include "src/compiler/turboshaft/required-optimization-reducer.h"
 #include "src/compiler/turboshaft/select-lowering-reducer.h"
 #include "src/compiler/turboshaft/variable-reducer.h"
@@ -22,7 +24,14 @@ void MachineLoweringPhase::Run(PipelineData* data, Zone* temp_zone) {
   // and it would be better to not tie the Maglev graph builder to
   // SimplifiedLowering just yet, so I'm hijacking MachineLoweringPhase to run
   // JSGenericLoweringReducer without requiring a whole phase just for that.
-  CopyingPhase<JSGenericLoweringReducer, DataViewLoweringReducer,
+  // LoopBoundsCheckEliminationReducer runs here rather than after loop
+  // unrolling, since unrolled iterations don't use the loop phi as index
+  // anymore. PartialEscapeAnalysisReducer runs here rather than in the
+  // OptimizePhase, since MemoryOptimizationReducer's allocation folding
+  // doesn't expect allocations to be emitted at other places than the ones of
+  // the input graph.
+  CopyingPhase<LoopBoundsCheckEliminationReducer, PartialEscapeAnalysisReducer,
+               JSGenericLoweringReducer, DataViewLoweringReducer,
                MachineLoweringReducer, FastApiCallLoweringReducer,
                SelectLoweringReducer,
                MachineOptimizationReducer>::Run(data, temp_zone);
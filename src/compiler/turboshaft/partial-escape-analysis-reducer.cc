@@ -0,0 +1,251 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/partial-escape-analysis-reducer.h"
+
+#include <algorithm>
+
+#include "src/compiler/turboshaft/loop-finder.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void PartialEscapeAnalysisAnalyzer::Run() {
+  CollectUses();
+  if (allocations_.empty()) return;
+
+  LoopFinder loop_finder(phase_zone_, &graph_);
+  for (OpIndex alloc : allocations_) {
+    TrySinkAllocation(alloc, loop_finder);
+  }
+}
+
+// Collects the Allocate operations as well as the uses of Allocate and
+// FrameState operations.
+void PartialEscapeAnalysisAnalyzer::CollectUses() {
+  for (auto& op : graph_.AllOperations()) {
+    if (ShouldSkipOperation(op)) continue;
+    OpIndex op_index = graph_.Index(op);
+    for (OpIndex input : op.inputs()) {
+      const Operation& input_op = graph_.Get(input);
+      if (input_op.Is<AllocateOp>() || input_op.Is<FrameStateOp>()) {
+        auto [it, new_entry] = uses_.try_emplace(input, phase_zone_);
+        it->second.push_back(op_index);
+      }
+    }
+    if (op.Is<AllocateOp>()) {
+      allocations_.push_back(op_index);
+    }
+  }
+}
+
+bool PartialEscapeAnalysisAnalyzer::IsInitializingStore(
+    OpIndex alloc, const Block* alloc_block, OpIndex use) const {
+  const StoreOp* store = graph_.Get(use).TryCast<StoreOp>();
+  if (!store) return false;
+  if (store->base() != alloc || store->value() == alloc) return false;
+  if (store->index().valid() || !store->maybe_initializing_or_transitioning) {
+    return false;
+  }
+  if (store->kind != StoreOp::Kind::Aligned(BaseTaggedness::kTaggedBase)) {
+    return false;
+  }
+  if (BlockOf(use) != alloc_block) return false;
+  // Re-emitting stores of other allocations would require ordering their
+  // materializations; we just don't sink such allocations.
+  return !graph_.Get(store->value()).Is<AllocateOp>();
+}
+
+void PartialEscapeAnalysisAnalyzer::TrySinkAllocation(
+    OpIndex alloc_idx, const LoopFinder& loop_finder) {
+  auto uses_it = uses_.find(alloc_idx);
+  // Allocations without uses are removed by LateEscapeAnalysis.
+  if (uses_it == uses_.end()) return;
+
+  const AllocateOp& alloc = graph_.Get(alloc_idx).Cast<AllocateOp>();
+  Block* alloc_block = BlockOf(alloc_idx);
+  ZoneVector<OpIndex> stores(phase_zone_);
+  ZoneVector<OpIndex> frame_states(phase_zone_);
+  Block* materialization_block = nullptr;
+  for (OpIndex use : uses_it->second) {
+    if (IsInitializingStore(alloc_idx, alloc_block, use)) {
+      stores.push_back(use);
+      continue;
+    }
+    const Operation& op = graph_.Get(use);
+    if (op.Is<FrameStateOp>()) {
+      frame_states.push_back(use);
+      continue;
+    }
+    if (op.Is<PhiOp>()) {
+      // The allocation should be materialized in the predecessor of the phi,
+      // which we don't support for now.
+      return;
+    }
+    Block* use_block = BlockOf(use);
+    materialization_block =
+        materialization_block
+            ? materialization_block->GetCommonDominator(use_block)
+            : use_block;
+    if (materialization_block == alloc_block) return;
+  }
+
+  if (materialization_block == nullptr && frame_states.empty()) {
+    // LateEscapeAnalysis takes care of this allocation.
+    return;
+  }
+
+  if (materialization_block != nullptr) {
+    // Materializing the object in a deeper loop than the allocation would
+    // allocate a fresh object at each iteration.
+    const Block* materialization_loop =
+        InnermostLoop(loop_finder, materialization_block);
+    if (materialization_loop != nullptr &&
+        !IsInLoop(loop_finder, alloc_block, materialization_loop)) {
+      return;
+    }
+  }
+
+  std::stable_sort(stores.begin(), stores.end(), [&](OpIndex a, OpIndex b) {
+    return graph_.Get(a).Cast<StoreOp>().offset <
+           graph_.Get(b).Cast<StoreOp>().offset;
+  });
+
+  // The blocks that can be executed after the materialization without going
+  // through the allocation again. This includes the blocks after merges with
+  // paths on which the object wasn't materialized, which the materialization
+  // block doesn't dominate.
+  BitVector reachable(graph_.block_count(), phase_zone_);
+  if (materialization_block != nullptr) {
+    CollectReachableBlocks(materialization_block, alloc_block, &reachable);
+  }
+
+  bool needs_dematerialization = false;
+  for (OpIndex frame_state : frame_states) {
+    Block* frame_state_block = BlockOf(frame_state);
+    if (materialization_block != nullptr &&
+        frame_state_block->IsDominatedBy(materialization_block)) {
+      continue;
+    }
+    needs_dematerialization = true;
+    // If a frame state that describes the object as dematerialized can be used
+    // (directly or through its children) once the object has been
+    // materialized, the deoptimizer would create a second copy of an object
+    // that may already have escaped.
+    if (materialization_block != nullptr &&
+        IsUsedInBlocks(frame_state, reachable)) {
+      return;
+    }
+  }
+  if (needs_dematerialization && !CanBeDematerialized(alloc, stores)) return;
+
+  if (ShouldSkipOptimizationStep()) return;
+
+  SunkAllocation sunk{alloc.size(), alloc.type, materialization_block,
+                      ZoneVector<InitializingStore>(phase_zone_),
+                      kObjectIdBase + alloc_idx.id()};
+  sunk.initializing_stores.reserve(stores.size());
+  for (OpIndex store_idx : stores) {
+    const StoreOp& store = graph_.Get(store_idx).Cast<StoreOp>();
+    sunk.initializing_stores.push_back({store.value(), store.stored_rep,
+                                        store.write_barrier, store.offset});
+  }
+  sunk_allocations_.emplace(alloc_idx, std::move(sunk));
+  // The stores aren't killed, since this would remove the uses of the stored
+  // values, which the copying phase would then skip although the
+  // materialization or the frame states need them. The reducer skips them
+  // instead, like the allocation itself.
+  sunk_stores_.insert(stores.begin(), stores.end());
+
+  if (materialization_block != nullptr) {
+    auto [it, new_entry] =
+        materializations_.try_emplace(materialization_block, phase_zone_);
+    it->second.push_back(alloc_idx);
+  }
+}
+
+// The deoptimizer can only recreate objects whose layout is fully described
+// by the frame state: we require a JSObject whose fields are all initialized
+// (in order) by tagged stores.
+bool PartialEscapeAnalysisAnalyzer::CanBeDematerialized(
+    const AllocateOp& alloc, const ZoneVector<OpIndex>& stores) const {
+  if (broker_ == nullptr || stores.empty()) return false;
+  uint64_t size;
+  if (!matcher_.MatchIntegralWordConstant(
+          alloc.size(), WordRepresentation::WordPtr(), &size)) {
+    return false;
+  }
+  if (size != stores.size() * kTaggedSize) return false;
+
+  for (size_t i = 0; i < stores.size(); ++i) {
+    const StoreOp& store = graph_.Get(stores[i]).Cast<StoreOp>();
+    if (store.offset != static_cast<int32_t>(i * kTaggedSize)) return false;
+    if (!store.stored_rep.IsTagged()) return false;
+  }
+
+  const StoreOp& map_store = graph_.Get(stores[0]).Cast<StoreOp>();
+  DCHECK_EQ(map_store.offset, HeapObject::kMapOffset);
+  Handle<HeapObject> map_handle;
+  if (!matcher_.MatchTaggedConstant(map_store.value(), &map_handle)) {
+    return false;
+  }
+  UnparkedScopeIfNeeded scope(broker_);
+  OptionalHeapObjectRef ref = TryMakeRef(broker_, map_handle);
+  if (!ref.has_value() || !ref->IsMap()) return false;
+  MapRef map = ref->AsMap();
+  return map.instance_type() == JS_OBJECT_TYPE &&
+         static_cast<uint64_t>(map.instance_size()) == size;
+}
+
+// Collects the blocks reachable from {start} (including {start}) without going
+// through {barrier}.
+void PartialEscapeAnalysisAnalyzer::CollectReachableBlocks(
+    const Block* start, const Block* barrier, BitVector* reachable) const {
+  base::SmallVector<const Block*, 16> worklist{start};
+  reachable->Add(start->index().id());
+  while (!worklist.empty()) {
+    const Block* current = worklist.back();
+    worklist.pop_back();
+    for (const Block* succ : SuccessorBlocks(*current, graph_)) {
+      if (succ == barrier || reachable->Contains(succ->index().id())) continue;
+      reachable->Add(succ->index().id());
+      worklist.push_back(succ);
+    }
+  }
+}
+
+bool PartialEscapeAnalysisAnalyzer::IsUsedInBlocks(
+    OpIndex frame_state, const BitVector& blocks) const {
+  if (blocks.Contains(graph_.BlockOf(frame_state).id())) return true;
+  base::SmallVector<OpIndex, 8> worklist{frame_state};
+  while (!worklist.empty()) {
+    OpIndex current = worklist.back();
+    worklist.pop_back();
+    auto it = uses_.find(current);
+    if (it == uses_.end()) continue;
+    for (OpIndex use : it->second) {
+      if (blocks.Contains(graph_.BlockOf(use).id())) return true;
+      if (graph_.Get(use).Is<FrameStateOp>()) worklist.push_back(use);
+    }
+  }
+  return false;
+}
+
+const Block* PartialEscapeAnalysisAnalyzer::InnermostLoop(
+    const LoopFinder& loop_finder, const Block* block) const {
+  if (block->IsLoop()) return block;
+  return loop_finder.GetLoopHeader(block);
+}
+
+// Returns true if {block} is in {loop}, or in a loop nested in {loop}.
+bool PartialEscapeAnalysisAnalyzer::IsInLoop(const LoopFinder& loop_finder,
+                                             const Block* block,
+                                             const Block* loop) const {
+  for (const Block* current = InnermostLoop(loop_finder, block);
+       current != nullptr; current = loop_finder.GetLoopHeader(current)) {
+    if (current == loop) return true;
+  }
+  return false;
+}
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,342 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_PARTIAL_ESCAPE_ANALYSIS_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_PARTIAL_ESCAPE_ANALYSIS_REDUCER_H_
+
+#include "src/compiler/js-heap-broker.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/deopt-data.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operation-matcher.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/uniform-reducer-adapter.h"
+#include "src/utils/bit-vector.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+// PartialEscapeAnalysis sinks allocations that only escape on some paths
+// (typically, cold paths) to the point where they actually escape. For
+// instance, in
+//
+//    let o = { x, y };
+//    if (cond) { %DeoptimizeNow(); }
+//    if (rare) { sink.push(o); }
+//
+// the allocation of `o` is moved into the `rare` branch, and frame states that
+// are not dominated by this branch describe `o` as a dematerialized object, so
+// that the deoptimizer recreates it if needed. As a result, the path where
+// `rare` is false doesn't allocate anything.
+//
+// An allocation is sunk if:
+//  - its only uses besides the ones that would force it to exist are the
+//    stores that initialize it (in the allocation block) and frame states;
+//  - the common dominator D of these uses is strictly dominated by the
+//    allocation, and isn't in a deeper loop than the allocation (otherwise,
+//    the object could be materialized more than once);
+//  - frame states that aren't dominated by D can describe the object, which
+//    requires it to be a JSObject whose fields are all initialized by tagged
+//    stores;
+//  - none of these frame states can be used once D has been executed, for
+//    instance by a deopt after the merge of the escaping path with the other
+//    ones. Deoptimizing there on the escaping path would otherwise create a
+//    second copy of an object that has already escaped. Since the object's
+//    state isn't tracked per path, we don't sink the allocation at all then.
+// The object is then allocated and initialized when D is entered (after its
+// phis), using the values of the original initializing stores. The original
+// allocation and stores are skipped by the reducer; they stay in the input
+// graph so that the stored values keep their uses and are emitted.
+//
+// Note that allocations that escape nowhere (but are used by frame states) are
+// fully removed.
+
+class V8_EXPORT_PRIVATE PartialEscapeAnalysisAnalyzer {
+ public:
+  // What is needed to emit the initializing stores again when materializing
+  // the object.
+  struct InitializingStore {
+    OpIndex value;
+    MemoryRepresentation stored_rep;
+    WriteBarrierKind write_barrier;
+    int32_t offset;
+  };
+  struct SunkAllocation {
+    OpIndex size;
+    AllocationType type;
+    // The block on entry to which the allocation should be materialized, or
+    // nullptr if it is never materialized.
+    Block* materialization_block;
+    // Ordered by offset.
+    ZoneVector<InitializingStore> initializing_stores;
+    // Id of the object when it's part of a frame state.
+    uint32_t object_id;
+  };
+
+  PartialEscapeAnalysisAnalyzer(Zone* phase_zone, Graph& input_graph,
+                                JSHeapBroker* broker)
+      : phase_zone_(phase_zone),
+        graph_(input_graph),
+        matcher_(input_graph),
+        broker_(broker),
+        uses_(phase_zone),
+        allocations_(phase_zone),
+        sunk_allocations_(phase_zone),
+        sunk_stores_(phase_zone),
+        materializations_(phase_zone) {}
+
+  void Run();
+
+  // Maps blocks of the input graph to the allocations that should be
+  // materialized when entering them.
+  const ZoneAbslFlatHashMap<const Block*, ZoneVector<OpIndex>>&
+  materializations() const {
+    return materializations_;
+  }
+  bool HasMaterializations() const { return !materializations_.empty(); }
+
+  const SunkAllocation* GetSunkAllocation(OpIndex alloc) const {
+    auto it = sunk_allocations_.find(alloc);
+    if (it == sunk_allocations_.end()) return nullptr;
+    return &it->second;
+  }
+
+  // Returns true if {alloc} is only known as a dematerialized object in
+  // {block}.
+  bool IsDematerializedIn(const SunkAllocation& alloc,
+                          const Block* block) const {
+    return alloc.materialization_block == nullptr ||
+           !block->IsDominatedBy(alloc.materialization_block);
+  }
+
+  bool HasSunkAllocations() const { return !sunk_allocations_.empty(); }
+
+  // Returns true if {store} initializes a sunk allocation, in which case it
+  // is emitted with the materialization instead.
+  bool IsSunkStore(OpIndex store) const { return sunk_stores_.contains(store); }
+
+  // Dematerialized object ids have to be unique within a frame state chain.
+  // We use large ids to avoid colliding with the ones that TurboFan's escape
+  // analysis has already assigned.
+  static constexpr uint32_t kObjectIdBase = 1u << 30;
+
+ private:
+  void CollectUses();
+  void TrySinkAllocation(OpIndex alloc, const LoopFinder& loop_finder);
+  bool IsInitializingStore(OpIndex alloc, const Block* alloc_block,
+                           OpIndex use) const;
+  bool CanBeDematerialized(const AllocateOp& alloc,
+                           const ZoneVector<OpIndex>& stores) const;
+  void CollectReachableBlocks(const Block* start, const Block* barrier,
+                              BitVector* reachable) const;
+  bool IsUsedInBlocks(OpIndex frame_state, const BitVector& blocks) const;
+  const Block* InnermostLoop(const LoopFinder& loop_finder,
+                             const Block* block) const;
+  bool IsInLoop(const LoopFinder& loop_finder, const Block* block,
+                const Block* loop) const;
+  Block* BlockOf(OpIndex op) const { return &graph_.Get(graph_.BlockOf(op)); }
+
+  Zone* phase_zone_;
+  Graph& graph_;
+  const OperationMatcher matcher_;
+  JSHeapBroker* broker_;
+
+  // The uses of each AllocateOp and FrameStateOp.
+  ZoneAbslFlatHashMap<OpIndex, ZoneVector<OpIndex>> uses_;
+  ZoneVector<OpIndex> allocations_;
+  ZoneAbslFlatHashMap<OpIndex, SunkAllocation> sunk_allocations_;
+  ZoneAbslFlatHashSet<OpIndex> sunk_stores_;
+  ZoneAbslFlatHashMap<const Block*, ZoneVector<OpIndex>> materializations_;
+};
+
+template <class Next>
+class PartialEscapeAnalysisReducer
+    : public UniformReducerAdapter<PartialEscapeAnalysisReducer, Next> {
+ public:
+  TURBOSHAFT_REDUCER_BOILERPLATE(PartialEscapeAnalysis)
+
+  using Adapter = UniformReducerAdapter<PartialEscapeAnalysisReducer, Next>;
+
+  void Analyze() {
+    if (v8_flags.turboshaft_partial_escape_analysis) {
+      analyzer_.Run();
+    }
+    Next::Analyze();
+  }
+
+  // Materializations are triggered by binding their block, which doesn't
+  // happen for blocks that are inlined into their predecessor.
+  bool CanAutoInlineBlocksWithSinglePredecessor() const {
+    return !analyzer_.HasMaterializations() &&
+           Next::CanAutoInlineBlocksWithSinglePredecessor();
+  }
+
+  void Bind(Block* new_block) {
+    Next::Bind(new_block);
+    if (!analyzer_.HasMaterializations()) return;
+    if (output_materializations_.empty()) {
+      for (const auto& [block, allocs] : analyzer_.materializations()) {
+        output_materializations_.emplace(__ MapToNewGraph(block), &allocs);
+      }
+    }
+    // The allocations are only emitted once the phis of the block have been,
+    // since the phis have to stay at the beginning of the block. Blocks that
+    // reducers create while lowering an operation are bound after that.
+    auto it = output_materializations_.find(new_block);
+    pending_materializations_ =
+        it == output_materializations_.end() ? nullptr : it->second;
+  }
+
+  template <typename Op, typename Continuation>
+  OpIndex ReduceInputGraphOperation(OpIndex ig_index, const Op& op) {
+    if constexpr (!std::is_same_v<Op, PhiOp>) MaterializePendingAllocations();
+    return Continuation{this}.ReduceInputGraph(ig_index, op);
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Allocate)(OpIndex ig_index,
+                                       const AllocateOp& alloc) {
+    MaterializePendingAllocations();
+    if (analyzer_.GetSunkAllocation(ig_index) != nullptr) {
+      return OpIndex::Invalid();
+    }
+    return Adapter::ReduceInputGraphAllocate(ig_index, alloc);
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Store)(OpIndex ig_index, const StoreOp& store) {
+    MaterializePendingAllocations();
+    if (analyzer_.IsSunkStore(ig_index)) return OpIndex::Invalid();
+    return Adapter::ReduceInputGraphStore(ig_index, store);
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(FrameState)(OpIndex ig_index,
+                                         const FrameStateOp& frame_state) {
+    LABEL_BLOCK(no_change) {
+      return Adapter::ReduceInputGraphFrameState(ig_index, frame_state);
+    }
+    MaterializePendingAllocations();
+    if (!analyzer_.HasSunkAllocations()) goto no_change;
+
+    const Block* block = __ current_input_block();
+    bool needs_dematerialization = false;
+    for (OpIndex input : frame_state.inputs()) {
+      const auto* sunk = analyzer_.GetSunkAllocation(input);
+      if (sunk && analyzer_.IsDematerializedIn(*sunk, block)) {
+        needs_dematerialization = true;
+        break;
+      }
+    }
+    if (!needs_dematerialization) goto no_change;
+
+    return DematerializeSunkAllocations(frame_state, block);
+  }
+
+ private:
+  void MaterializePendingAllocations() {
+    if (pending_materializations_ == nullptr) return;
+    const ZoneVector<OpIndex>* allocs = pending_materializations_;
+    pending_materializations_ = nullptr;
+    for (OpIndex alloc : *allocs) Materialize(alloc);
+  }
+
+  void Materialize(OpIndex alloc) {
+    const auto* sunk = analyzer_.GetSunkAllocation(alloc);
+    DCHECK_NOT_NULL(sunk);
+    Uninitialized<HeapObject> object = __ template Allocate<HeapObject>(
+        __ MapToNewGraph(sunk->size), sunk->type);
+    for (const auto& store : sunk->initializing_stores) {
+      __ Initialize(object, __ MapToNewGraph(store.value), store.stored_rep,
+                    store.write_barrier, store.offset);
+    }
+    __ CreateOldToNewMapping(alloc, __ FinishInitialization(std::move(object)));
+  }
+
+  OpIndex DematerializeSunkAllocations(const FrameStateOp& frame_state,
+                                       const Block* block) {
+    FrameStateData::Builder builder;
+    base::SmallVector<uint32_t, 4> emitted_ids;
+    auto it = frame_state.data->iterator(frame_state.state_values());
+
+    if (frame_state.inlined) {
+      builder.AddParentFrameState(
+          __ MapToNewGraph(frame_state.parent_frame_state()));
+    }
+    while (it.has_more()) {
+      switch (it.current_instr()) {
+        case FrameStateData::Instr::kInput: {
+          MachineType type;
+          OpIndex input;
+          it.ConsumeInput(&type, &input);
+          const auto* sunk = analyzer_.GetSunkAllocation(input);
+          if (sunk == nullptr || !analyzer_.IsDematerializedIn(*sunk, block)) {
+            builder.AddInput(type, __ MapToNewGraph(input));
+          } else if (std::find(emitted_ids.begin(), emitted_ids.end(),
+                               sunk->object_id) != emitted_ids.end()) {
+            builder.AddDematerializedObjectReference(sunk->object_id);
+          } else {
+            emitted_ids.push_back(sunk->object_id);
+            builder.AddDematerializedObject(
+                sunk->object_id,
+                static_cast<uint32_t>(sunk->initializing_stores.size()));
+            for (const auto& store : sunk->initializing_stores) {
+              builder.AddInput(MachineType::AnyTagged(),
+                               __ MapToNewGraph(store.value));
+            }
+          }
+          break;
+        }
+        case FrameStateData::Instr::kUnusedRegister:
+          it.ConsumeUnusedRegister();
+          builder.AddUnusedRegister();
+          break;
+        case FrameStateData::Instr::kDematerializedObject: {
+          uint32_t id;
+          uint32_t field_count;
+          it.ConsumeDematerializedObject(&id, &field_count);
+          builder.AddDematerializedObject(id, field_count);
+          break;
+        }
+        case FrameStateData::Instr::kDematerializedObjectReference: {
+          uint32_t id;
+          it.ConsumeDematerializedObjectReference(&id);
+          builder.AddDematerializedObjectReference(id);
+          break;
+        }
+        case FrameStateData::Instr::kArgumentsElements: {
+          CreateArgumentsType type;
+          it.ConsumeArgumentsElements(&type);
+          builder.AddArgumentsElements(type);
+          break;
+        }
+        case FrameStateData::Instr::kArgumentsLength:
+          it.ConsumeArgumentsLength();
+          builder.AddArgumentsLength();
+          break;
+      }
+    }
+
+    return __ FrameState(builder.Inputs(), builder.inlined(),
+                         builder.AllocateFrameStateData(
+                             frame_state.data->frame_state_info,
+                             __ output_graph().graph_zone()));
+  }
+
+  PartialEscapeAnalysisAnalyzer analyzer_{Asm().phase_zone(),
+                                          Asm().modifiable_input_graph(),
+                                          Asm().data()->broker()};
+  // Maps blocks of the output graph to the allocations to materialize in them.
+  ZoneAbslFlatHashMap<const Block*, const ZoneVector<OpIndex>*>
+      output_materializations_{Asm().phase_zone()};
+  // The allocations to materialize before the next non-phi operation.
+  const ZoneVector<OpIndex>* pending_materializations_ = nullptr;
+};
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_PARTIAL_ESCAPE_ANALYSIS_REDUCER_H_
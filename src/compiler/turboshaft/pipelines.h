@@ -342,7 +342,11 @@ class Pipeline final {
     Run<MeetRegisterConstraintsPhase>();
     Run<ResolvePhisPhase>();
     Run<BuildLiveRangesPhase>();
-    Run<BuildLiveRangeBundlesPhase>();
+    bool use_fast_allocation =
+        data_->register_allocation_data()->use_fast_allocation();
+    if (!use_fast_allocation) {
+      Run<BuildLiveRangeBundlesPhase>();
+    }
 
     TraceSequence("before register allocation");
     if (verifier != nullptr) {
@@ -385,7 +389,7 @@ class Pipeline final {
 
     Run<PopulateReferenceMapsPhase>();
 
-    if (v8_flags.turbo_move_optimization) {
+    if (v8_flags.turbo_move_optimization && !use_fast_allocation) {
       Run<OptimizeMovesPhase>();
     }
 
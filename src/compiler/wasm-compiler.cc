@@ -3661,7 +3661,8 @@ std::pair<Node*, BoundsCheckResult> WasmGraphBuilder::BoundsCheckMem(
     if (memory->is_memory64) {
       auto done = gasm_->MakeLabel(MachineRepresentation::kWord64);
       Node* cond = gasm_->Uint64LessThan(
-          converted_index, Int64Constant(memory->GetMemory64GuardsSize()));
+          converted_index,
+          Int64Constant(wasm::WasmMemory::GetMemory64GuardedIndexLimit()));
       gasm_->GotoIf(cond, &done, BranchHint::kTrue, converted_index);
 
       if (static_cast<bool>(alignment_check) && align_mask != 0 &&
@@ -7443,9 +7444,32 @@ class WasmWrapperGraphBuilder : public WasmGraphBuilder {
         gasm_->Bind(&done);
         return done.PhiAt(0);
       }
+      case wasm::kI64: {
+        // Like {BigInt::AsInt64}: the value is the least significant digit,
+        // negated for negative BigInts.
+        DCHECK(mcgraph()->machine()->Is64());
+        auto done = gasm_->MakeLabel(MachineRepresentation::kWord64);
+        Node* bitfield = gasm_->LoadFromObject(
+            MachineType::Uint32(), input,
+            wasm::ObjectAccess::ToTagged(
+                AccessBuilder::ForBigIntBitfield().offset));
+        gasm_->GotoIf(gasm_->Word32Equal(bitfield, Int32Constant(0)), &done,
+                      Int64Constant(0));
+        Node* lsd = gasm_->LoadFromObject(
+            MachineType::Uint64(), input,
+            wasm::ObjectAccess::ToTagged(
+                AccessBuilder::ForBigIntLeastSignificantDigit64().offset));
+        Node* sign =
+            gasm_->Word32And(bitfield, Int32Constant(BigInt::SignBits::kMask));
+        gasm_->GotoIf(sign, &done, gasm_->Int64Sub(Int64Constant(0), lsd));
+        gasm_->Goto(&done, lsd);
+        gasm_->Bind(&done);
+        return done.PhiAt(0);
+      }
       case wasm::kRef:
       case wasm::kRefNull:
-      case wasm::kI64:
+        // Externrefs are passed on unmodified.
+        return input;
       case wasm::kRtt:
       case wasm::kS128:
       case wasm::kI8:
@@ -7577,7 +7601,15 @@ class WasmWrapperGraphBuilder : public WasmGraphBuilder {
       switch (type.kind()) {
         case wasm::kRef:
         case wasm::kRefNull:
+          if (type.heap_representation_non_shared() !=
+              wasm::HeapType::kExtern) {
+            return false;
+          }
+          break;
         case wasm::kI64:
+          // The BigInt is only converted inline if its digits are 64 bits.
+          if (!mcgraph()->machine()->Is64()) return false;
+          break;
         case wasm::kRtt:
         case wasm::kS128:
         case wasm::kI8:
@@ -7625,9 +7657,26 @@ class WasmWrapperGraphBuilder : public WasmGraphBuilder {
         gasm_->Bind(&done);
         return;
       }
+      case wasm::kI64: {
+        gasm_->GotoIf(IsSmi(input), slow_path);
+        Node* map = gasm_->LoadMap(input);
+        Node* bigint_map = LOAD_ROOT(BigIntMap, bigint_map);
+#if V8_MAP_PACKING
+        Node* is_bigint = gasm_->WordEqual(bigint_map, map);
+#else
+        Node* is_bigint = gasm_->TaggedEqual(bigint_map, map);
+#endif
+        gasm_->GotoIfNot(is_bigint, slow_path);
+        return;
+      }
       case wasm::kRef:
+        // The slow path throws the TypeError for null.
+        gasm_->GotoIf(
+            gasm_->TaggedEqual(input, LOAD_ROOT(NullValue, null_value)),
+            slow_path);
+        return;
       case wasm::kRefNull:
-      case wasm::kI64:
+        return;
       case wasm::kRtt:
       case wasm::kS128:
       case wasm::kI8:
@@ -9,7 +9,9 @@
 #include "src/compiler/wasm-compiler.h"
 #include "src/compiler/wasm-graph-assembler.h"
 #include "src/wasm/decoder.h"
+#include "src/wasm/object-access.h"
 #include "src/wasm/wasm-linkage.h"
+#include "src/wasm/wasm-objects.h"
 #include "src/wasm/wasm-opcodes-inl.h"
 #include "src/wasm/wasm-subtyping.h"
 
@@ -153,6 +155,86 @@ class WasmIntoJSInlinerImpl : private wasm::Decoder {
         case wasm::kExprLocalGet:
           stack.push_back(ParseLocalGet());
           continue;
+        case wasm::kExprI32Const:
+          stack.push_back(TypeNode(mcgraph_->Int32Constant(consume_i32v()),
+                                   wasm::kWasmI32));
+          continue;
+        case wasm::kExprF32Const: {
+          float value = base::bit_cast<float>(read_u32<ValidationTag>(pc_));
+          pc_ += sizeof(value);
+          stack.push_back(
+              TypeNode(mcgraph_->Float32Constant(value), wasm::kWasmF32));
+          continue;
+        }
+        case wasm::kExprF64Const: {
+          double value = base::bit_cast<double>(read_u64<ValidationTag>(pc_));
+          pc_ += sizeof(value);
+          stack.push_back(
+              TypeNode(mcgraph_->Float64Constant(value), wasm::kWasmF64));
+          continue;
+        }
+        case wasm::kExprI32Eqz:
+          DCHECK(!stack.empty());
+          stack.back() = TypeNode(
+              gasm_.Word32Equal(stack.back().node, mcgraph_->Int32Constant(0)),
+              wasm::kWasmI32);
+          continue;
+        case wasm::kExprI32Add:
+        case wasm::kExprI32Sub:
+        case wasm::kExprI32Mul:
+        case wasm::kExprI32And:
+        case wasm::kExprI32Ior:
+        case wasm::kExprI32Xor:
+        case wasm::kExprI32Shl:
+        case wasm::kExprI32ShrS:
+        case wasm::kExprI32ShrU:
+        case wasm::kExprI32Eq:
+        case wasm::kExprI32Ne:
+        case wasm::kExprI32LtS:
+        case wasm::kExprI32LtU:
+        case wasm::kExprI32GtS:
+        case wasm::kExprI32GtU:
+        case wasm::kExprI32LeS:
+        case wasm::kExprI32LeU:
+        case wasm::kExprI32GeS:
+        case wasm::kExprI32GeU:
+        case wasm::kExprF32Add:
+        case wasm::kExprF32Sub:
+        case wasm::kExprF32Mul:
+        case wasm::kExprF32Div:
+        case wasm::kExprF64Add:
+        case wasm::kExprF64Sub:
+        case wasm::kExprF64Mul:
+        case wasm::kExprF64Div: {
+          DCHECK_GE(stack.size(), 2);
+          Value rhs = stack.back();
+          stack.pop_back();
+          stack.back() = ParseBinop(stack.back(), rhs, opcode);
+          continue;
+        }
+        case wasm::kExprI32LoadMem:
+        case wasm::kExprI32LoadMem8S:
+        case wasm::kExprI32LoadMem8U:
+        case wasm::kExprI32LoadMem16S:
+        case wasm::kExprI32LoadMem16U:
+        case wasm::kExprF32LoadMem:
+        case wasm::kExprF64LoadMem:
+          DCHECK(!stack.empty());
+          stack.back() = ParseLoadMem(stack.back(), opcode);
+          continue;
+        case wasm::kExprI32StoreMem:
+        case wasm::kExprI32StoreMem8:
+        case wasm::kExprI32StoreMem16:
+        case wasm::kExprF32StoreMem:
+        case wasm::kExprF64StoreMem: {
+          DCHECK_GE(stack.size(), 2);
+          Value value = stack.back();
+          stack.pop_back();
+          Value index = stack.back();
+          stack.pop_back();
+          ParseStoreMem(index, value, opcode);
+          continue;
+        }
         case wasm::kExprDrop:
           DCHECK(!stack.empty());
           stack.pop_back();
@@ -332,6 +414,276 @@ class WasmIntoJSInlinerImpl : private wasm::Decoder {
     gasm_.ArraySet(array.node, index.node, value.node, array_type);
   }
 
+  Value ParseBinop(Value lhs, Value rhs, WasmOpcode opcode) {
+    MachineOperatorBuilder* m = mcgraph_->machine();
+    Node* left = lhs.node;
+    Node* right = rhs.node;
+    const Operator* op;
+    switch (opcode) {
+      case wasm::kExprI32Add:
+        op = m->Int32Add();
+        break;
+      case wasm::kExprI32Sub:
+        op = m->Int32Sub();
+        break;
+      case wasm::kExprI32Mul:
+        op = m->Int32Mul();
+        break;
+      case wasm::kExprI32And:
+        op = m->Word32And();
+        break;
+      case wasm::kExprI32Ior:
+        op = m->Word32Or();
+        break;
+      case wasm::kExprI32Xor:
+        op = m->Word32Xor();
+        break;
+      case wasm::kExprI32Shl:
+        op = m->Word32Shl();
+        right = MaskShiftCount32(right);
+        break;
+      case wasm::kExprI32ShrS:
+        op = m->Word32Sar();
+        right = MaskShiftCount32(right);
+        break;
+      case wasm::kExprI32ShrU:
+        op = m->Word32Shr();
+        right = MaskShiftCount32(right);
+        break;
+      case wasm::kExprI32Eq:
+        op = m->Word32Equal();
+        break;
+      case wasm::kExprI32Ne:
+        return TypeNode(gasm_.Word32Equal(gasm_.Word32Equal(left, right),
+                                          mcgraph_->Int32Constant(0)),
+                        wasm::kWasmI32);
+      case wasm::kExprI32LtS:
+        op = m->Int32LessThan();
+        break;
+      case wasm::kExprI32LtU:
+        op = m->Uint32LessThan();
+        break;
+      case wasm::kExprI32GtS:
+        op = m->Int32LessThan();
+        std::swap(left, right);
+        break;
+      case wasm::kExprI32GtU:
+        op = m->Uint32LessThan();
+        std::swap(left, right);
+        break;
+      case wasm::kExprI32LeS:
+        op = m->Int32LessThanOrEqual();
+        break;
+      case wasm::kExprI32LeU:
+        op = m->Uint32LessThanOrEqual();
+        break;
+      case wasm::kExprI32GeS:
+        op = m->Int32LessThanOrEqual();
+        std::swap(left, right);
+        break;
+      case wasm::kExprI32GeU:
+        op = m->Uint32LessThanOrEqual();
+        std::swap(left, right);
+        break;
+      case wasm::kExprF32Add:
+        op = m->Float32Add();
+        break;
+      case wasm::kExprF32Sub:
+        op = m->Float32Sub();
+        break;
+      case wasm::kExprF32Mul:
+        op = m->Float32Mul();
+        break;
+      case wasm::kExprF32Div:
+        op = m->Float32Div();
+        break;
+      case wasm::kExprF64Add:
+        op = m->Float64Add();
+        break;
+      case wasm::kExprF64Sub:
+        op = m->Float64Sub();
+        break;
+      case wasm::kExprF64Mul:
+        op = m->Float64Mul();
+        break;
+      case wasm::kExprF64Div:
+        op = m->Float64Div();
+        break;
+      default:
+        UNREACHABLE();
+    }
+    return TypeNode(graph_->NewNode(op, left, right),
+                    WasmOpcodes::Signature(opcode)->GetReturn());
+  }
+
+  Node* MaskShiftCount32(Node* node) {
+    if (mcgraph_->machine()->Word32ShiftIsSafe()) return node;
+    return gasm_.Word32And(node, mcgraph_->Int32Constant(0x1F));
+  }
+
+  Value ParseLoadMem(Value index, WasmOpcode opcode) {
+    MachineType type;
+    switch (opcode) {
+      case wasm::kExprI32LoadMem:
+        type = MachineType::Int32();
+        break;
+      case wasm::kExprI32LoadMem8S:
+        type = MachineType::Int8();
+        break;
+      case wasm::kExprI32LoadMem8U:
+        type = MachineType::Uint8();
+        break;
+      case wasm::kExprI32LoadMem16S:
+        type = MachineType::Int16();
+        break;
+      case wasm::kExprI32LoadMem16U:
+        type = MachineType::Uint16();
+        break;
+      case wasm::kExprF32LoadMem:
+        type = MachineType::Float32();
+        break;
+      case wasm::kExprF64LoadMem:
+        type = MachineType::Float64();
+        break;
+      default:
+        UNREACHABLE();
+    }
+    uintptr_t offset;
+    const wasm::WasmMemory* memory = ReadMemoryAccess(&offset);
+    if (memory == nullptr) return {};
+    Node* converted_index =
+        BoundsCheckMem(memory, type.MemSize(), index.node, offset);
+    Node* mem_buffer = MemBuffer(memory->index, offset);
+    Node* load =
+        mcgraph_->machine()->UnalignedLoadSupported(type.representation())
+            ? gasm_.Load(type, mem_buffer, converted_index)
+            : gasm_.LoadUnaligned(type, mem_buffer, converted_index);
+    return TypeNode(load, WasmOpcodes::Signature(opcode)->GetReturn());
+  }
+
+  void ParseStoreMem(Value index, Value value, WasmOpcode opcode) {
+    MachineRepresentation rep;
+    switch (opcode) {
+      case wasm::kExprI32StoreMem:
+        rep = MachineRepresentation::kWord32;
+        break;
+      case wasm::kExprI32StoreMem8:
+        rep = MachineRepresentation::kWord8;
+        break;
+      case wasm::kExprI32StoreMem16:
+        rep = MachineRepresentation::kWord16;
+        break;
+      case wasm::kExprF32StoreMem:
+        rep = MachineRepresentation::kFloat32;
+        break;
+      case wasm::kExprF64StoreMem:
+        rep = MachineRepresentation::kFloat64;
+        break;
+      default:
+        UNREACHABLE();
+    }
+    uintptr_t offset;
+    const wasm::WasmMemory* memory = ReadMemoryAccess(&offset);
+    if (memory == nullptr) return;
+    Node* converted_index = BoundsCheckMem(
+        memory, ElementSizeInBytes(rep), index.node, offset);
+    Node* mem_buffer = MemBuffer(memory->index, offset);
+    if (mcgraph_->machine()->UnalignedStoreSupported(rep)) {
+      gasm_.Store(StoreRepresentation(rep, kNoWriteBarrier), mem_buffer,
+                  converted_index, value.node);
+    } else {
+      gasm_.StoreUnaligned(rep, mem_buffer, converted_index, value.node);
+    }
+  }
+
+  // Reads the memory access immediate and returns the accessed memory, or
+  // nullptr if accesses to it are not supported.
+  const wasm::WasmMemory* ReadMemoryAccess(uintptr_t* offset) {
+#if V8_TARGET_BIG_ENDIAN
+    // Wasm memory is little-endian, we don't inline the byte swapping.
+    is_inlineable_ = false;
+    return nullptr;
+#else
+    uint32_t alignment = consume_u32v();
+    uint32_t memory_index = 0;
+    if (alignment & 0x40) memory_index = consume_u32v();
+    DCHECK_LT(memory_index, module_->memories.size());
+    const wasm::WasmMemory* memory = &module_->memories[memory_index];
+    if (memory->is_memory64) {
+      is_inlineable_ = false;
+      return nullptr;
+    }
+    *offset = consume_u32v();
+    return memory;
+#endif
+  }
+
+  // The trap handler is not available in JavaScript code, so accesses are
+  // always bounds-checked explicitly. Returns the index converted to uintptr.
+  Node* BoundsCheckMem(const wasm::WasmMemory* memory, int access_size,
+                       Node* index, uintptr_t offset) {
+    Node* converted_index = gasm_.BuildChangeUint32ToUintPtr(index);
+    if (memory->bounds_checks == wasm::kNoBoundsChecks) {
+      return converted_index;
+    }
+    // Check that the last accessed byte at {index + end_offset} is in bounds,
+    // see {WasmGraphBuilder::BoundsCheckMem}.
+    uintptr_t end_offset = offset + access_size - 1u;
+    Node* mem_size = LoadMemSize(memory->index);
+    Node* end_offset_node = mcgraph_->UintPtrConstant(end_offset);
+    if (end_offset > memory->min_memory_size) {
+      gasm_.TrapUnless(gasm_.UintLessThan(end_offset_node, mem_size),
+                       TrapId::kTrapMemOutOfBounds);
+      SetSourcePosition(gasm_.effect());
+    }
+    Node* effective_size = gasm_.IntSub(mem_size, end_offset_node);
+    gasm_.TrapUnless(gasm_.UintLessThan(converted_index, effective_size),
+                     TrapId::kTrapMemOutOfBounds);
+    SetSourcePosition(gasm_.effect());
+    return converted_index;
+  }
+
+  // The memory start and size are reloaded for each access, as the
+  // surrounding JavaScript code can grow the memory.
+  Node* LoadMemStart(uint32_t memory_index) {
+    if (memory_index == 0) {
+      return gasm_.Load(MachineType::Pointer(), trusted_data_node_,
+                        wasm::ObjectAccess::ToTagged(
+                            WasmTrustedInstanceData::kMemory0StartOffset));
+    }
+    return gasm_.LoadByteArrayElement(
+        LoadMemoryBasesAndSizes(), gasm_.IntPtrConstant(2 * memory_index),
+        MachineType::Pointer());
+  }
+
+  Node* LoadMemSize(uint32_t memory_index) {
+    if (memory_index == 0) {
+      return gasm_.Load(MachineType::UintPtr(), trusted_data_node_,
+                        wasm::ObjectAccess::ToTagged(
+                            WasmTrustedInstanceData::kMemory0SizeOffset));
+    }
+    return gasm_.LoadByteArrayElement(
+        LoadMemoryBasesAndSizes(), gasm_.IntPtrConstant(2 * memory_index + 1),
+        MachineType::UintPtr());
+  }
+
+  Node* LoadMemoryBasesAndSizes() {
+    // Use {LoadByteArrayElement} on the result even though it's a trusted
+    // array; their layout is the same.
+    static_assert(FixedAddressArray::OffsetOfElementAt(0) ==
+                  TrustedFixedAddressArray::OffsetOfElementAt(0));
+    return gasm_.LoadImmutableProtectedPointerFromObject(
+        trusted_data_node_,
+        wasm::ObjectAccess::ToTagged(
+            WasmTrustedInstanceData::kProtectedMemoryBasesAndSizesOffset));
+  }
+
+  Node* MemBuffer(uint32_t memory_index, uintptr_t offset) {
+    Node* mem_start = LoadMemStart(memory_index);
+    if (offset == 0) return mem_start;
+    return gasm_.IntAdd(mem_start, mcgraph_->UintPtrConstant(offset));
+  }
+
   WasmOpcode ReadOpcode() {
     DCHECK_LT(pc_, end_);
     instruction_start_ = pc();
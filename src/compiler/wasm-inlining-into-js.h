@@ -26,7 +26,8 @@ class Node;
 class SourcePositionTable;
 
 // The WasmIntoJsInliner provides support for inlining very small wasm functions
-// which only contain very specific supported instructions into JS.
+// which only contain very specific supported instructions into JS: wasm-gc
+// object accesses, i32 / f32 / f64 arithmetic and linear memory accesses.
 class WasmIntoJSInliner {
  public:
   static bool TryInlining(Zone* zone, const wasm::WasmModule* module,
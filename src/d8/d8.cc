@@ -494,22 +494,6 @@ static platform::tracing::TraceConfig* CreateTraceConfigFromJSON(
 
 }  // namespace tracing
 
-class ExternalOwningOneByteStringResource
-    : public String::ExternalOneByteStringResource {
- public:
-  ExternalOwningOneByteStringResource() = default;
-  ExternalOwningOneByteStringResource(
-      std::unique_ptr<base::OS::MemoryMappedFile> file)
-      : file_(std::move(file)) {}
-  const char* data() const override {
-    return static_cast<char*>(file_->memory());
-  }
-  size_t length() const override { return file_->size(); }
-
- private:
-  std::unique_ptr<base::OS::MemoryMappedFile> file_;
-};
-
 // static variables:
 CounterMap* Shell::counter_map_;
 base::SharedMutex Shell::counter_mutex_;
@@ -4147,6 +4131,12 @@ void Shell::ReadLine(const v8::FunctionCallbackInfo<v8::Value>& info) {
 // Reads a file into a v8 string.
 MaybeLocal<String> Shell::ReadFile(Isolate* isolate, const char* name,
                                    bool should_throw) {
+  if (i::v8_flags.use_external_strings) {
+    Local<String> result;
+    if (String::NewExternalOneByteFromFile(isolate, name).ToLocal(&result)) {
+      return result;
+    }
+  }
   std::unique_ptr<base::OS::MemoryMappedFile> file(
       base::OS::MemoryMappedFile::open(
           name, base::OS::MemoryMappedFile::FileMode::kReadOnly));
@@ -4164,11 +4154,6 @@ MaybeLocal<String> Shell::ReadFile(Isolate* isolate, const char* name,
 
   int size = static_cast<int>(file->size());
   char* chars = static_cast<char*>(file->memory());
-  if (i::v8_flags.use_external_strings && i::String::IsAscii(chars, size)) {
-    String::ExternalOneByteStringResource* resource =
-        new ExternalOwningOneByteStringResource(std::move(file));
-    return String::NewExternalOneByte(isolate, resource);
-  }
   return String::NewFromUtf8(isolate, chars, NewStringType::kNormal, size);
 }
 
@@ -1983,6 +1983,7 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK_EQ(arr->get(JSRegExp::kIrregexpTicksUntilTierUpIndex),
                uninitialized);
       CHECK_EQ(arr->get(JSRegExp::kIrregexpBacktrackLimit), uninitialized);
+      CHECK_EQ(arr->get(JSRegExp::kIrregexpLiteralPrefixIndex), uninitialized);
       break;
     }
     case JSRegExp::IRREGEXP: {
@@ -2023,6 +2024,12 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)));
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpTicksUntilTierUpIndex)));
       CHECK(IsSmi(arr->get(JSRegExp::kIrregexpBacktrackLimit)));
+      Tagged<Object> literal_prefix =
+          arr->get(JSRegExp::kIrregexpLiteralPrefixIndex);
+      CHECK((IsSmi(literal_prefix) &&
+             Smi::ToInt(literal_prefix) == JSRegExp::kUninitializedValue) ||
+            (IsSeqOneByteString(literal_prefix) &&
+             String::cast(literal_prefix)->length() > 0));
       break;
     }
     default:
@@ -593,6 +593,7 @@ DEFINE_WEAK_NEG_IMPLICATION(maglev_future, maglev_loop_peeling_only_trivial)
 DEFINE_WEAK_IMPLICATION(maglev_future, maglev_speculative_hoist_phi_untagging)
 DEFINE_WEAK_IMPLICATION(maglev_future, maglev_inline_api_calls)
 DEFINE_WEAK_IMPLICATION(maglev_future, maglev_escape_analysis)
+DEFINE_WEAK_IMPLICATION(maglev_future, maglev_licm)
 // This might be too big of a hammer but we must prohibit moving the C++
 // trampolines while we are executing a C++ code.
 DEFINE_NEG_IMPLICATION(maglev_inline_api_calls, compact_code_space_with_stack)
@@ -618,6 +619,15 @@ DEFINE_INT(max_maglev_inlined_bytecode_size_small, 27,
            "maximum size of bytecode considered for small function inlining")
 DEFINE_FLOAT(min_maglev_inlining_frequency, 0.10,
              "minimum frequency for inlining")
+DEFINE_BOOL(maglev_polymorphic_inlining, true,
+            "dispatch on the target of calls whose target is known to be one "
+            "of a few functions, and inline them in maglev")
+DEFINE_INT(max_maglev_polymorphic_inlining_targets, 4,
+           "maximum number of targets of a polymorphic call that Maglev will "
+           "dispatch on")
+DEFINE_INT(max_maglev_polymorphic_inlined_bytecode_size, 460,
+           "maximum cumulative size of bytecode of the targets of a single "
+           "polymorphic call")
 DEFINE_WEAK_VALUE_IMPLICATION(turbofan, max_maglev_inline_depth, 1)
 DEFINE_WEAK_VALUE_IMPLICATION(turbofan, max_maglev_inlined_bytecode_size, 100)
 DEFINE_WEAK_VALUE_IMPLICATION(turbofan,
@@ -634,6 +644,8 @@ DEFINE_EXPERIMENTAL_FEATURE(
     "enable phi untagging to hoist untagging of loop phi inputs (could "
     "still cause deopt loops)")
 DEFINE_BOOL(maglev_cse, true, "common subexpression elimination")
+DEFINE_BOOL(maglev_licm, false,
+            "hoist loop-invariant checks and loads out of loop headers")
 
 DEFINE_STRING(maglev_filter, "*", "optimization filter for the maglev compiler")
 DEFINE_BOOL(maglev_assert, false, "insert extra assertion in maglev code")
@@ -1319,6 +1331,10 @@ DEFINE_STRING(
 DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
             "verify register allocation in TurboFan")
 DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
+DEFINE_INT(turbo_fast_register_allocation_threshold, 100000,
+           "number of instructions from which register allocation uses "
+           "cheaper heuristics, trading code quality for compile time "
+           "(0 to disable)")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "TurboFan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "TurboFan loop variable optimization")
@@ -1391,6 +1407,12 @@ DEFINE_BOOL(turboshaft_load_elimination, true,
 DEFINE_BOOL(turboshaft_loop_peeling, false, "enable Turboshaft's loop peeling")
 DEFINE_BOOL(turboshaft_loop_unrolling, true,
             "enable Turboshaft's loop unrolling")
+DEFINE_BOOL(turboshaft_loop_bounds_check_elimination, true,
+            "enable Turboshaft's elimination of bounds checks on loop "
+            "induction variables")
+DEFINE_BOOL(turboshaft_partial_escape_analysis, false,
+            "enable Turboshaft's partial escape analysis, which sinks "
+            "allocations to the paths where they escape")
 
 DEFINE_EXPERIMENTAL_FEATURE(turboshaft_typed_optimizations,
                             "enable an additional Turboshaft phase that "
@@ -1416,6 +1438,7 @@ DEFINE_EXPERIMENTAL_FEATURE(
     "enable Turboshaft features that we want to ship in the not-too-far future")
 DEFINE_IMPLICATION(turboshaft_future, turboshaft)
 DEFINE_WEAK_IMPLICATION(turboshaft_future, turboshaft_loop_peeling)
+DEFINE_WEAK_IMPLICATION(turboshaft_future, turboshaft_partial_escape_analysis)
 DEFINE_WEAK_IMPLICATION(turboshaft_future, turboshaft_wasm)
 #if V8_TARGET_ARCH_X64 or V8_TARGET_ARCH_ARM64 or V8_TARGET_ARCH_ARM or \
     V8_TARGET_ARCH_IA32
@@ -1572,6 +1595,9 @@ DEFINE_DEBUG_BOOL(trace_wasm_stack_switching, false,
                   "trace wasm stack switching")
 DEFINE_INT(wasm_stack_switching_stack_size, V8_DEFAULT_STACK_SIZE_KB,
            "default size of stacks for wasm stack-switching (in kB)")
+DEFINE_SIZE_T(wasm_stack_pool_max_size, 8 * MB / KB,
+              "maximum size of the deleted wasm stack-switching stacks that "
+              "are kept for reuse (in kB)")
 DEFINE_BOOL(liftoff, true,
             "enable Liftoff, the baseline compiler for WebAssembly")
 DEFINE_BOOL(liftoff_only, false,
@@ -1580,6 +1606,9 @@ DEFINE_IMPLICATION(liftoff_only, liftoff)
 DEFINE_NEG_IMPLICATION(liftoff_only, wasm_tier_up)
 DEFINE_NEG_IMPLICATION(liftoff_only, wasm_dynamic_tiering)
 DEFINE_NEG_IMPLICATION(fuzzing, liftoff_only)
+DEFINE_BOOL(liftoff_cache_loop_locals, false,
+            "keep the locals used most in a loop in registers across its "
+            "back-edges in Liftoff code")
 DEFINE_DEBUG_BOOL(
     enable_testing_opcode_in_wasm, false,
     "enables a testing opcode in wasm that is only implemented in TurboFan")
@@ -1730,6 +1759,9 @@ DEFINE_BOOL(wasm_lazy_compilation, true,
             "enable lazy compilation for all wasm modules")
 DEFINE_DEBUG_BOOL(trace_wasm_lazy_compilation, false,
                   "trace lazy compilation of wasm functions")
+DEFINE_BOOL(wasm_lazy_deserialization, false,
+            "deserialize the code of a cached wasm module on the first call "
+            "of each function instead of upfront")
 DEFINE_EXPERIMENTAL_FEATURE(
     wasm_lazy_validation,
     "enable lazy validation for lazily compiled wasm functions")
@@ -1790,6 +1822,10 @@ DEFINE_BOOL_READONLY(wasm_memory64_trap_handling, false,
                      "Use trap handling for Wasm memory64 bounds checks (not "
                      "supported for this architecture)")
 #endif  // V8_TARGET_ARCH_ARM64 || V8_TARGET_ARCH_X64
+DEFINE_UINT(wasm_memory64_guarded_max_gb, 16,
+            "maximum size in GiB of memory64 memories that use trap handling "
+            "for bounds checks; all of them reserve twice that size of "
+            "address space, larger ones use explicit bounds checks")
 
 #endif  // V8_ENABLE_WEBASSEMBLY
 
@@ -2571,6 +2607,9 @@ DEFINE_INT(regexp_tier_up_ticks, 1,
            "tiering-up to the compiler")
 DEFINE_BOOL(regexp_peephole_optimization, REGEXP_PEEPHOLE_OPTIMIZATION_BOOL,
             "enable peephole optimization for regexp bytecode")
+DEFINE_BOOL(regexp_literal_prefix_search, true,
+            "search for the literal prefix of a regexp before running the "
+            "matcher")
 DEFINE_BOOL(trace_regexp_peephole_optimization, false,
             "trace regexp bytecode peephole optimization")
 DEFINE_BOOL(trace_regexp_bytecodes, false, "trace regexp bytecode execution")
@@ -2578,6 +2617,8 @@ DEFINE_BOOL(trace_regexp_assembler, false,
             "trace regexp macro assembler calls.")
 DEFINE_BOOL(trace_regexp_parser, false, "trace regexp parsing")
 DEFINE_BOOL(trace_regexp_tier_up, false, "trace regexp tiering up execution")
+DEFINE_BOOL(trace_regexp_stack, false,
+            "trace regexps whose native code grows the backtrack stack")
 DEFINE_BOOL(trace_regexp_graph, false, "trace the regexp graph")
 
 DEFINE_BOOL(enable_experimental_regexp_engine, false,
@@ -2588,6 +2629,9 @@ DEFINE_IMPLICATION(default_to_experimental_regexp_engine,
                    enable_experimental_regexp_engine)
 DEFINE_BOOL(trace_experimental_regexp_engine, false,
             "trace execution of experimental regexp engine")
+DEFINE_BOOL(experimental_regexp_engine_dfa, true,
+            "find match boundaries with a lazily built DFA in the "
+            "experimental regexp engine")
 
 DEFINE_BOOL(enable_experimental_regexp_engine_on_excessive_backtracks, false,
             "fall back to a breadth-first regexp engine on excessive "
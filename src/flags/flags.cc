@@ -471,6 +471,11 @@ uint32_t ComputeFlagListHash() {
     // code caching.
     if (flag.PointsTo(&v8_flags.random_seed)) continue;
     if (flag.PointsTo(&v8_flags.predictable)) continue;
+#if V8_ENABLE_WEBASSEMBLY
+    // Lazy deserialization only changes when serialized wasm code is
+    // deserialized, so it must not invalidate that code.
+    if (flag.PointsTo(&v8_flags.wasm_lazy_deserialization)) continue;
+#endif  // V8_ENABLE_WEBASSEMBLY
 
     // The following flags are implied by --predictable (some negated).
     if (flag.PointsTo(&v8_flags.concurrent_sparkplug) ||
@@ -3973,6 +3973,7 @@ void Factory::SetRegExpIrregexpData(DirectHandle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, ticks_until_tier_up);
   store->set(JSRegExp::kIrregexpBacktrackLimit, Smi::FromInt(backtrack_limit));
+  store->set(JSRegExp::kIrregexpLiteralPrefixIndex, uninitialized);
   regexp->set_data(store);
 }
 
@@ -3997,6 +3998,7 @@ void Factory::SetRegExpExperimentalData(DirectHandle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store->set(JSRegExp::kIrregexpTicksUntilTierUpIndex, uninitialized);
   store->set(JSRegExp::kIrregexpBacktrackLimit, uninitialized);
+  store->set(JSRegExp::kIrregexpLiteralPrefixIndex, uninitialized);
   regexp->set_data(store);
 }
 
@@ -28,6 +28,7 @@
 #include "src/sandbox/sandbox.h"
 #include "src/sandbox/testing.h"
 #include "src/snapshot/snapshot.h"
+#include "src/strings/string-simd.h"
 #if defined(V8_USE_PERFETTO)
 #include "src/tracing/code-data-source.h"
 #endif  // defined(V8_USE_PERFETTO)
@@ -231,6 +232,7 @@ void V8::Initialize() {
   Simulator::InitializeOncePerProcess();
 #endif
   CpuFeatures::Probe(false);
+  StringSimd::InitializeOncePerProcess();
   ElementsAccessor::InitializeOncePerProcess();
   Bootstrapper::InitializeOncePerProcess();
   CallDescriptors::InitializeOncePerProcess();
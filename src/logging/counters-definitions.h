@@ -82,6 +82,10 @@ namespace internal {
   /* Backtracks observed in a single regexp interpreter execution. */          \
   /* The maximum of 100M backtracks takes roughly 2 seconds on my machine. */  \
   HR(regexp_backtracks, V8.RegExpBacktracks, 1, 100000000, 50)                 \
+  /* Size in KB that the backtrack stack of native regexp code grew to, */     \
+  /* sampled when executions that outgrew the static stack are done. */        \
+  HR(regexp_stack_high_water_mark, V8.RegExpStackHighWaterMarkKB, 1, 65536,    \
+     50)                                                                       \
   /* Number of times a cache event is triggered for a wasm module. */          \
   HR(wasm_cache_count, V8.WasmCacheCount, 0, 100, 101)                         \
   HR(wasm_streaming_until_compilation_finished,                                \
@@ -385,7 +389,15 @@ namespace internal {
   SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)                      \
   SC(wasm_reloc_size, V8.WasmRelocBytes)                                       \
   SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)           \
-  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)
+  SC(wasm_compiled_export_wrapper, V8.WasmCompiledExportWrappers)              \
+  SC(wasm_export_wrapper_cache_hits, V8.WasmExportWrapperCacheHits)            \
+  SC(wasm_export_wrapper_cache_misses, V8.WasmExportWrapperCacheMisses)        \
+  SC(wasm_import_wrapper_cache_hits, V8.WasmImportWrapperCacheHits)            \
+  SC(wasm_import_wrapper_cache_misses, V8.WasmImportWrapperCacheMisses)        \
+  SC(wasm_stack_pool_hits, V8.WasmStackPoolHits)                               \
+  SC(wasm_stack_pool_misses, V8.WasmStackPoolMisses)                           \
+  /* Size of the live wasm stack-switching stacks. */                          \
+  SC(wasm_stack_memory_bytes, V8.WasmStackMemoryBytes)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
@@ -40,6 +40,7 @@
 #include "src/maglev/maglev-interpreter-frame-state.h"
 #include "src/maglev/maglev-ir-inl.h"
 #include "src/maglev/maglev-ir.h"
+#include "src/maglev/maglev-licm.h"
 #include "src/maglev/maglev-phi-representation-selector.h"
 #include "src/maglev/maglev-regalloc-data.h"
 #include "src/maglev/maglev-regalloc.h"
@@ -649,6 +650,19 @@ bool MaglevCompiler::Compile(LocalIsolate* local_isolate,
         PrintGraph(std::cout, compilation_info, graph);
       }
     }
+
+    if (v8_flags.maglev_licm) {
+      TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                   "V8.Maglev.LoopInvariantCodeMotion");
+
+      GraphProcessor<MaglevLoopInvariantCodeMotion> licm(compilation_info);
+      licm.ProcessGraph(graph);
+
+      if (v8_flags.print_maglev_graphs) {
+        std::cout << "\nAfter loop-invariant code motion" << std::endl;
+        PrintGraph(std::cout, compilation_info, graph);
+      }
+    }
   }
 
 #ifdef DEBUG
@@ -8510,6 +8510,98 @@ ReduceResult MaglevGraphBuilder::ReduceCallForTarget(
   return ReduceCallForConstant(target, args, feedback_source, speculation_mode);
 }
 
+// Call sites whose feedback went megamorphic often still have a target that is
+// statically one of a few functions, e.g. a method loaded from a polymorphic
+// receiver, for which the property load merges the per-map constants into a
+// phi. In that case we dispatch on the target and reduce the call for each of
+// the possible functions (which allows inlining them), instead of emitting a
+// generic call.
+ReduceResult MaglevGraphBuilder::TryReduceCallForPolymorphicTarget(
+    ValueNode* target_node, CallArguments& args,
+    const compiler::FeedbackSource& feedback_source,
+    SpeculationMode speculation_mode) {
+  if (!v8_flags.maglev_polymorphic_inlining) return ReduceResult::Fail();
+  if (args.mode() != CallArguments::kDefault) return ReduceResult::Fail();
+  Phi* phi = target_node->TryCast<Phi>();
+  // The inputs of loop phis aren't all known yet.
+  if (phi == nullptr || phi->is_exception_phi() || phi->is_loop_phi()) {
+    return ReduceResult::Fail();
+  }
+
+  base::SmallVector<compiler::JSFunctionRef, 4> targets;
+  int bytecode_size = 0;
+  for (int i = 0; i < phi->input_count(); i++) {
+    compiler::OptionalHeapObjectRef constant =
+        TryGetConstant(phi->input(i).node());
+    if (!constant.has_value() || !constant->IsJSFunction()) {
+      return ReduceResult::Fail();
+    }
+    compiler::JSFunctionRef target = constant->AsJSFunction();
+    if (std::any_of(targets.begin(), targets.end(),
+                    [&](compiler::JSFunctionRef other) {
+                      return other.equals(target);
+                    })) {
+      continue;
+    }
+    if (static_cast<int>(targets.size()) >=
+        v8_flags.max_maglev_polymorphic_inlining_targets) {
+      TRACE_INLINING("  cannot dispatch on polymorphic call target: too many "
+                     "targets");
+      return ReduceResult::Fail();
+    }
+    compiler::SharedFunctionInfoRef shared = target.shared(broker());
+    if (shared.HasBytecodeArray()) {
+      bytecode_size += shared.GetBytecodeArray(broker()).length();
+    }
+    targets.push_back(target);
+  }
+  if (bytecode_size > v8_flags.max_maglev_polymorphic_inlined_bytecode_size) {
+    TRACE_INLINING("  cannot dispatch on polymorphic call target: cumulative "
+                   "size ("
+                   << bytecode_size << ") >= max-size ("
+                   << v8_flags.max_maglev_polymorphic_inlined_bytecode_size
+                   << ")");
+    return ReduceResult::Fail();
+  }
+  DCHECK(!targets.empty());
+  if (targets.size() == 1) {
+    return ReduceCallForConstant(targets[0], args, feedback_source,
+                                 speculation_mode);
+  }
+
+  TRACE_INLINING("  dispatching on " << targets.size()
+                                     << " polymorphic call targets");
+  MaglevSubGraphBuilder sub_graph(this, 1);
+  MaglevSubGraphBuilder::Variable ret_val(0);
+  MaglevSubGraphBuilder::Label done(&sub_graph,
+                                    static_cast<int>(targets.size()),
+                                    {&ret_val});
+  for (size_t i = 0; i < targets.size(); i++) {
+    // We don't need to check the last target, since the phi can't have any
+    // other value.
+    base::Optional<MaglevSubGraphBuilder::Label> call_next_target;
+    if (i < targets.size() - 1) {
+      call_next_target.emplace(&sub_graph, 1);
+      sub_graph.GotoIfFalse<BranchIfReferenceEqual>(
+          &*call_next_target, {target_node, GetConstant(targets[i])});
+    }
+    // Builtin reductions are allowed to modify the arguments.
+    CallArguments target_args = args;
+    ReduceResult result = ReduceCallForConstant(
+        targets[i], target_args, feedback_source, speculation_mode);
+    DCHECK(result.IsDoneWithValue() || result.IsDoneWithAbort());
+    if (result.IsDoneWithValue()) {
+      sub_graph.set(ret_val, result.value());
+    }
+    sub_graph.GotoOrTrim(&done);
+    if (call_next_target.has_value()) {
+      sub_graph.Bind(&*call_next_target);
+    }
+  }
+  RETURN_IF_ABORT(sub_graph.TrimPredecessorsAndBind(&done));
+  return sub_graph.get(ret_val);
+}
+
 ReduceResult MaglevGraphBuilder::ReduceCallForNewClosure(
     ValueNode* target_node, ValueNode* target_context,
     compiler::SharedFunctionInfoRef shared,
@@ -8759,6 +8851,10 @@ ReduceResult MaglevGraphBuilder::ReduceCall(
     RETURN_IF_DONE(result);
   }
 
+  RETURN_IF_DONE(TryReduceCallForPolymorphicTarget(target_node, args,
+                                                   feedback_source,
+                                                   speculation_mode));
+
   // On fallthrough, create a generic call.
   return BuildGenericCall(target_node, Call::TargetType::kAny, args);
 }
@@ -364,7 +364,8 @@ class MaglevGraphBuilder {
   DeoptFrame GetLatestCheckpointedFrame();
 
   bool need_checkpointed_loop_entry() {
-    return v8_flags.maglev_speculative_hoist_phi_untagging;
+    return v8_flags.maglev_speculative_hoist_phi_untagging ||
+           v8_flags.maglev_licm;
   }
 
   void RecordUseReprHint(Phi* phi, UseRepresentationSet reprs) {
@@ -1835,6 +1836,10 @@ class MaglevGraphBuilder {
       ValueNode* target_node, compiler::JSFunctionRef target,
       CallArguments& args, const compiler::FeedbackSource& feedback_source,
       SpeculationMode speculation_mode);
+  ReduceResult TryReduceCallForPolymorphicTarget(
+      ValueNode* target_node, CallArguments& args,
+      const compiler::FeedbackSource& feedback_source,
+      SpeculationMode speculation_mode);
   ReduceResult ReduceCallForNewClosure(
       ValueNode* target_node, ValueNode* target_context,
       compiler::SharedFunctionInfoRef shared,
@@ -0,0 +1,140 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/maglev/maglev-licm.h"
+
+#include "src/base/small-vector.h"
+#include "src/maglev/maglev-basic-block.h"
+#include "src/maglev/maglev-graph.h"
+#include "src/maglev/maglev-interpreter-frame-state.h"
+
+namespace v8 {
+namespace internal {
+namespace maglev {
+
+void MaglevLoopInvariantCodeMotion::PreProcessGraph(Graph* graph) {
+  // Loops are contiguous in the block order: their blocks are between the loop
+  // header and the JumpLoop, so we can compute which loops write to memory in
+  // a single pass, using a stack of the loops that we're in.
+  base::SmallVector<std::pair<BasicBlock*, bool>, 4> open_loops;
+  auto close_loop = [&]() {
+    auto [header, writes] = open_loops.back();
+    open_loops.pop_back();
+    if (!writes) return;
+    loops_with_writes_.insert(header);
+    if (!open_loops.empty()) open_loops.back().second = true;
+  };
+
+  for (BasicBlock* block : *graph) {
+    if (block->is_loop()) {
+      open_loops.emplace_back(block, false);
+      any_candidate_loop_ |= IsCandidateLoop(block);
+    }
+    if (!open_loops.empty() && !open_loops.back().second) {
+      for (Node* node : block->nodes()) {
+        if (node->properties().can_write() || node->properties().is_call()) {
+          open_loops.back().second = true;
+          break;
+        }
+      }
+    }
+    if (JumpLoop* jump_loop = block->control_node()->TryCast<JumpLoop>()) {
+      // Loop headers whose back-edge was never emitted might still be on the
+      // stack.
+      while (!open_loops.empty() &&
+             open_loops.back().first != jump_loop->target()) {
+        close_loop();
+      }
+      if (!open_loops.empty()) close_loop();
+    }
+  }
+}
+
+void MaglevLoopInvariantCodeMotion::PreProcessBasicBlock(BasicBlock* block) {
+  if (block->is_loop() && IsCandidateLoop(block)) {
+    HoistFromLoopHeader(block);
+  }
+}
+
+// We need a deopt checkpoint at the end of the preheader for the hoisted
+// checks.
+bool MaglevLoopInvariantCodeMotion::IsCandidateLoop(BasicBlock* header) const {
+  DCHECK(header->is_loop());
+  if (header->state()->is_resumable_loop()) return false;
+  if (header->predecessor_count() != 2) return false;
+  if (!header->predecessor_at(1)->control_node()->Is<JumpLoop>()) {
+    return false;
+  }
+  return header->predecessor_at(0)->control_node()->Is<CheckpointedJump>();
+}
+
+bool MaglevLoopInvariantCodeMotion::CanHoist(Node* node,
+                                             bool loop_writes) const {
+  switch (node->opcode()) {
+    // Checks that only depend on the value of their input.
+    case Opcode::kCheckSmi:
+    case Opcode::kCheckHeapObject:
+    case Opcode::kCheckNumber:
+    case Opcode::kCheckString:
+    case Opcode::kCheckSymbol:
+    case Opcode::kCheckValue:
+    case Opcode::kCheckInt32IsSmi:
+      break;
+    // Maps and fields might be changed by the loop.
+    case Opcode::kCheckMaps:
+    case Opcode::kCheckInstanceType:
+    case Opcode::kLoadTaggedField:
+    case Opcode::kLoadDoubleField:
+      if (loop_writes) return false;
+      break;
+    default:
+      return false;
+  }
+  for (Input& input : *node) {
+    if (!defined_nodes_.count(input.node())) return false;
+  }
+  return true;
+}
+
+void MaglevLoopInvariantCodeMotion::HoistFromLoopHeader(BasicBlock* header) {
+  BasicBlock* preheader = header->predecessor_at(0);
+  const DeoptFrame& preheader_frame = preheader->control_node()
+                                          ->Cast<CheckpointedJump>()
+                                          ->eager_deopt_info()
+                                          ->top_frame();
+  const bool loop_writes = loops_with_writes_.count(header) != 0;
+
+  for (auto it = header->nodes().begin(); it != header->nodes().end();) {
+    Node* node = *it;
+    if (!CanHoist(node, loop_writes)) {
+      // This node might be a check that guards the following nodes.
+      if (node->properties().can_deopt() || node->properties().can_write() ||
+          node->properties().can_throw()) {
+        return;
+      }
+      ++it;
+      continue;
+    }
+
+    if (node->properties().can_eager_deopt()) {
+      // The uses of the inputs of the previous frame are kept: they are only
+      // used to decide whether nodes are dead, and being conservative is fine.
+      // The inputs of the preheader frame are already used by its checkpoint.
+      EagerDeoptInfo* deopt_info = node->eager_deopt_info();
+      DeoptimizeReason reason = deopt_info->reason();
+      compiler::FeedbackSource feedback = deopt_info->feedback_to_update();
+      node->SetEagerDeoptInfo(zone_, preheader_frame, feedback);
+      node->eager_deopt_info()->set_reason(reason);
+    }
+    it = header->nodes().RemoveAt(it);
+    preheader->nodes().Add(node);
+    if (ValueNode* value = node->TryCast<ValueNode>()) {
+      defined_nodes_.insert(value);
+    }
+  }
+}
+
+}  // namespace maglev
+}  // namespace internal
+}  // namespace v8
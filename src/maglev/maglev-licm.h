@@ -0,0 +1,75 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_MAGLEV_MAGLEV_LICM_H_
+#define V8_MAGLEV_MAGLEV_LICM_H_
+
+#include <unordered_set>
+
+#include "src/maglev/maglev-compilation-info.h"
+#include "src/maglev/maglev-graph-processor.h"
+#include "src/maglev/maglev-ir.h"
+
+namespace v8 {
+namespace internal {
+namespace maglev {
+
+class Graph;
+
+// Loop-invariant code motion: moves checks and loads out of loop headers into
+// the loop preheader (the block that enters the loop).
+//
+// We only consider the nodes of the loop header block, since these are
+// executed every time the loop is entered: hoisting them doesn't introduce
+// deopts or loads that wouldn't otherwise have happened (which, for loads,
+// might not be guarded by the right checks). This notably covers the loop
+// condition, like the `a.length` load in `for (i = 0; i < a.length; i++)`,
+// which is otherwise re-executed on each iteration since loaded properties
+// don't survive the loop header.
+//
+// A node is hoisted if
+//  - it is a check on the value of its inputs, or a map check or a field load
+//    and the loop doesn't write to memory,
+//  - all of its inputs are defined before the loop, or are hoisted,
+//  - no node that we can't hoist and that could guard it (i.e., that can
+//    deopt) precedes it in the header.
+// Hoisted checks deopt to the checkpoint of the loop entry, which requires the
+// graph builder to enter loops with a CheckpointedJump.
+class MaglevLoopInvariantCodeMotion {
+ public:
+  explicit MaglevLoopInvariantCodeMotion(MaglevCompilationInfo* info)
+      : zone_(info->zone()) {}
+
+  void PreProcessGraph(Graph* graph);
+  void PostProcessGraph(Graph* graph) {}
+  void PreProcessBasicBlock(BasicBlock* block);
+
+  template <typename NodeT>
+  ProcessResult Process(NodeT* node, const ProcessingState& state) {
+    if constexpr (IsValueNode(Node::opcode_of<NodeT>)) {
+      if (any_candidate_loop_) defined_nodes_.insert(node);
+    }
+    return ProcessResult::kContinue;
+  }
+
+ private:
+  bool IsCandidateLoop(BasicBlock* header) const;
+  bool CanHoist(Node* node, bool loop_writes) const;
+  void HoistFromLoopHeader(BasicBlock* header);
+
+  Zone* zone_;
+  bool any_candidate_loop_ = false;
+  // Loop headers of loops (including their inner loops) that can write to
+  // memory.
+  std::unordered_set<BasicBlock*> loops_with_writes_;
+  // The value nodes that have been visited, i.e. that are defined before the
+  // current block, as well as the hoisted nodes.
+  std::unordered_set<ValueNode*> defined_nodes_;
+};
+
+}  // namespace maglev
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_MAGLEV_MAGLEV_LICM_H_
@@ -36,7 +36,6 @@ constexpr uint64_t kNegativeGuardSize = uint64_t{2} * GB;
 
 #if V8_TARGET_ARCH_64_BIT
 constexpr uint64_t kFullGuardSize32 = uint64_t{10} * GB;
-constexpr uint64_t kFullGuardSize64 = uint64_t{32} * GB;
 #endif
 
 #endif  // V8_ENABLE_WEBASSEMBLY
@@ -67,13 +66,9 @@ base::AddressRegion GetReservedRegion(bool has_guard_regions,
     DCHECK_EQ(0, start % AllocatePageSize());
     if (is_wasm_memory64) {
       DCHECK(v8_flags.wasm_memory64_trap_handling);
-      static_assert(kFullGuardSize64 ==
-                    2 * wasm::kV8MaxWasmMemory64Pages * wasm::kWasmPageSize);
-      DCHECK_LE(byte_capacity,
-                wasm::kV8MaxWasmMemory64Pages * wasm::kWasmPageSize);
-      return base::AddressRegion(
-          start,
-          1ULL << wasm::WasmMemory::GetMemory64GuardsShift(byte_capacity));
+      DCHECK_LE(byte_capacity, wasm::WasmMemory::GetMemory64MaxGuardedSize());
+      return base::AddressRegion(start,
+                                 wasm::WasmMemory::GetMemory64GuardsSize());
     } else {
       // Guard regions always look like this:
       // |xxx(2GiB)xxx|.......(4GiB)..xxxxx|xxxxxx(4GiB)xxxxxx|
@@ -98,11 +93,8 @@ size_t GetReservationSize(bool has_guard_regions, size_t byte_capacity,
   if (has_guard_regions) {
     if (is_wasm_memory64) {
       DCHECK(v8_flags.wasm_memory64_trap_handling);
-      static_assert(kFullGuardSize64 ==
-                    2 * wasm::kV8MaxWasmMemory64Pages * wasm::kWasmPageSize);
-      DCHECK_LE(byte_capacity,
-                wasm::kV8MaxWasmMemory64Pages * wasm::kWasmPageSize);
-      return 1ULL << wasm::WasmMemory::GetMemory64GuardsShift(byte_capacity);
+      DCHECK_LE(byte_capacity, wasm::WasmMemory::GetMemory64MaxGuardedSize());
+      return wasm::WasmMemory::GetMemory64GuardsSize();
     } else {
       static_assert(kFullGuardSize32 >= size_t{4} * GB);
       DCHECK_LE(byte_capacity, size_t{4} * GB);
@@ -319,9 +311,13 @@ std::unique_ptr<BackingStore> BackingStore::TryAllocateAndPartiallyCommitMemory(
 
 #if V8_ENABLE_WEBASSEMBLY
   bool is_wasm_memory64 = wasm_memory == WasmMemoryFlag::kWasmMemory64;
+  // Memory64 memories that can grow beyond the guarded size use explicit
+  // bounds checks, see {UpdateComputedInformation}.
   bool guards = trap_handler::IsTrapHandlerEnabled() &&
                 (wasm_memory == WasmMemoryFlag::kWasmMemory32 ||
-                 (is_wasm_memory64 && v8_flags.wasm_memory64_trap_handling));
+                 (is_wasm_memory64 && v8_flags.wasm_memory64_trap_handling &&
+                  maximum_pages * page_size <=
+                      wasm::WasmMemory::GetMemory64MaxGuardedSize()));
 #else
   CHECK_EQ(WasmMemoryFlag::kNotWasm, wasm_memory);
   constexpr bool is_wasm_memory64 = false;
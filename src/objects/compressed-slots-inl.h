@@ -270,12 +270,15 @@ void OffHeapCompressedObjectSlot<CompressionScheme>::Release_Store(
 }
 
 template <typename CompressionScheme>
-void OffHeapCompressedObjectSlot<CompressionScheme>::Release_CompareAndSwap(
+Tagged<Object>
+OffHeapCompressedObjectSlot<CompressionScheme>::Release_CompareAndSwap(
     Tagged<Object> old, Tagged<Object> target) const {
   Tagged_t old_ptr = CompressionScheme::CompressObject(old.ptr());
   Tagged_t target_ptr = CompressionScheme::CompressObject(target.ptr());
-  AsAtomicTagged::Release_CompareAndSwap(TSlotBase::location(), old_ptr,
-                                         target_ptr);
+  Tagged_t result = AsAtomicTagged::Release_CompareAndSwap(
+      TSlotBase::location(), old_ptr, target_ptr);
+  return Tagged<Object>(
+      CompressionScheme::DecompressTagged(TSlotBase::address(), result));
 }
 
 }  // namespace v8::internal
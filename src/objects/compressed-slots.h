@@ -178,8 +178,8 @@ class OffHeapCompressedObjectSlot
   inline Tagged<Object> Acquire_Load(PtrComprCageBase cage_base) const;
   inline void Relaxed_Store(Tagged<Object> value) const;
   inline void Release_Store(Tagged<Object> value) const;
-  inline void Release_CompareAndSwap(Tagged<Object> old,
-                                     Tagged<Object> target) const;
+  inline Tagged<Object> Release_CompareAndSwap(Tagged<Object> old,
+                                               Tagged<Object> target) const;
 };
 
 #endif  // V8_COMPRESS_POINTERS
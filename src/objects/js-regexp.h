@@ -209,7 +209,12 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // above to save space.
   static constexpr int kIrregexpBacktrackLimit =
       kIrregexpTicksUntilTierUpIndex + 1;
-  static constexpr int kIrregexpDataSize = kIrregexpBacktrackLimit + 1;
+  // A one-byte String that every match must start with, or a Smi marker value
+  // equal to kUninitializedValue. Used to skip ahead to candidate match
+  // positions before entering the matcher.
+  static constexpr int kIrregexpLiteralPrefixIndex =
+      kIrregexpBacktrackLimit + 1;
+  static constexpr int kIrregexpDataSize = kIrregexpLiteralPrefixIndex + 1;
 
   // TODO(mbid,v8:10765): At the moment the EXPERIMENTAL data array conforms
   // to the format of an IRREGEXP data array, with most fields set to some
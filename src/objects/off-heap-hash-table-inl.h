@@ -38,7 +38,8 @@ void OffHeapHashTableBase<Derived>::RehashInto(PtrComprCageBase cage_base,
     derived_this->CopyEntryExcludingKeyInto(cage_base, i, new_table,
                                             insertion_index);
   }
-  new_table->number_of_elements_ = number_of_elements();
+  new_table->number_of_elements_.store(number_of_elements(),
+                                       std::memory_order_relaxed);
 }
 
 template <typename Derived>
@@ -49,15 +50,16 @@ inline bool OffHeapHashTableBase<Derived>::ShouldResizeToAdd(
   // is sufficiently empty; otherwise we make sure to grow it so that it has
   // enough space.
   int capacity_after_shrinking = ComputeCapacityWithShrink(
-      capacity_, number_of_elements_ + additional_elements);
+      capacity_, number_of_elements() + additional_elements);
 
   if (capacity_after_shrinking < capacity_) {
-    DCHECK(HasSufficientCapacityToAdd(
-        capacity_after_shrinking, number_of_elements_, 0, additional_elements));
+    DCHECK(HasSufficientCapacityToAdd(capacity_after_shrinking,
+                                      number_of_elements(), 0,
+                                      additional_elements));
     *new_capacity = capacity_after_shrinking;
     return true;
   } else if (!HasSufficientCapacityToAdd(additional_elements)) {
-    *new_capacity = ComputeCapacity(number_of_elements_ + additional_elements);
+    *new_capacity = ComputeCapacity(number_of_elements() + additional_elements);
     return true;
   } else {
     *new_capacity = -1;
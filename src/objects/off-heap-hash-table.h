@@ -5,6 +5,8 @@
 #ifndef V8_OBJECTS_OFF_HEAP_HASH_TABLE_H_
 #define V8_OBJECTS_OFF_HEAP_HASH_TABLE_H_
 
+#include <atomic>
+
 #include "src/common/globals.h"
 #include "src/execution/isolate-utils.h"
 #include "src/objects/compressed-slots.h"
@@ -75,8 +77,12 @@ class OffHeapHashTableBase {
   }
 
   int capacity() const { return capacity_; }
-  int number_of_elements() const { return number_of_elements_; }
-  int number_of_deleted_elements() const { return number_of_deleted_elements_; }
+  int number_of_elements() const {
+    return number_of_elements_.load(std::memory_order_relaxed);
+  }
+  int number_of_deleted_elements() const {
+    return number_of_deleted_elements_.load(std::memory_order_relaxed);
+  }
 
   OffHeapObjectSlot slot(InternalIndex index, int offset = 0) const {
     DCHECK_LT(offset, Derived::kEntrySize);
@@ -89,11 +95,11 @@ class OffHeapHashTableBase {
     Derived* derived_this = static_cast<Derived*>(this);
 
     DCHECK_EQ(derived_this->GetKey(cage_base, entry), empty_element());
-    DCHECK_LT(number_of_elements_ + 1, capacity());
+    DCHECK_LT(number_of_elements() + 1, capacity());
     DCHECK(HasSufficientCapacityToAdd(1));
 
     derived_this->Set(entry, std::forward<Args>(args)...);
-    number_of_elements_++;
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
   }
 
   template <typename... Args>
@@ -102,19 +108,19 @@ class OffHeapHashTableBase {
     Derived* derived_this = static_cast<Derived*>(this);
 
     DCHECK_EQ(derived_this->GetKey(cage_base, entry), deleted_element());
-    DCHECK_LT(number_of_elements_ + 1, capacity());
+    DCHECK_LT(number_of_elements() + 1, capacity());
     DCHECK(HasSufficientCapacityToAdd(capacity(), number_of_elements(),
                                       number_of_deleted_elements() - 1, 1));
 
     derived_this->Set(entry, std::forward<Args>(args)...);
-    number_of_elements_++;
-    number_of_deleted_elements_--;
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
+    number_of_deleted_elements_.fetch_sub(1, std::memory_order_relaxed);
   }
 
   void ElementsRemoved(int count) {
-    DCHECK_LE(count, number_of_elements_);
-    number_of_elements_ -= count;
-    number_of_deleted_elements_ += count;
+    DCHECK_LE(count, number_of_elements());
+    number_of_elements_.fetch_sub(count, std::memory_order_relaxed);
+    number_of_deleted_elements_.fetch_add(count, std::memory_order_relaxed);
   }
 
   size_t GetSizeExcludingHeader() const {
@@ -179,8 +185,10 @@ class OffHeapHashTableBase {
 
   static inline void Free(void* container);
 
-  int number_of_elements_;
-  int number_of_deleted_elements_;
+  // The counts are atomic so that tables can support concurrent insertions,
+  // see e.g. the string table.
+  std::atomic<int> number_of_elements_;
+  std::atomic<int> number_of_deleted_elements_;
   const int capacity_;
   Tagged_t elements_[1];
 };
@@ -7,7 +7,9 @@
 
 #include "src/base/logging.h"
 #include "src/common/globals.h"
+#include "src/objects/objects.h"
 #include "src/objects/string.h"
+#include "src/strings/string-simd.h"
 #include "src/utils/utils.h"
 
 namespace v8 {
@@ -56,12 +58,23 @@ class StringComparator {
   static inline bool Equals(State* state_1, State* state_2, int to_check) {
     const Chars1* a = reinterpret_cast<const Chars1*>(state_1->buffer8_);
     const Chars2* b = reinterpret_cast<const Chars2*>(state_2->buffer8_);
-    return CompareCharsEqual(a, b, to_check);
+    return CompareCharsEqualWithSimd(a, b, to_check);
   }
 
   bool Equals(Tagged<String> string_1, Tagged<String> string_2,
               const SharedStringAccessGuardIfNeeded& access_guard);
 
+  template <typename Chars1, typename Chars2>
+  static inline int Compare(State* state_1, State* state_2, int to_check) {
+    const Chars1* a = reinterpret_cast<const Chars1*>(state_1->buffer8_);
+    const Chars2* b = reinterpret_cast<const Chars2*>(state_2->buffer8_);
+    return CompareChars(a, b, to_check);
+  }
+
+  // Compares the strings lexicographically by code units.
+  ComparisonResult Compare(Tagged<String> string_1, Tagged<String> string_2,
+                           const SharedStringAccessGuardIfNeeded& access_guard);
+
  private:
   State state_1_;
   State state_2_;
@@ -20,6 +20,7 @@
 #include "src/sandbox/external-pointer-inl.h"
 #include "src/sandbox/external-pointer.h"
 #include "src/strings/string-hasher-inl.h"
+#include "src/strings/string-simd.h"
 #include "src/strings/unicode-inl.h"
 #include "src/torque/runtime-macro-shims.h"
 #include "src/torque/runtime-support.h"
@@ -586,21 +587,21 @@ bool String::IsEqualToImpl(
     int32_t type = string->map()->instance_type();
     switch (type & kStringRepresentationAndEncodingMask) {
       case kSeqOneByteStringTag:
-        return CompareCharsEqual(
+        return CompareCharsEqualWithSimd(
             SeqOneByteString::cast(string)->GetChars(no_gc, access_guard) +
                 slice_offset,
             data, len);
       case kSeqTwoByteStringTag:
-        return CompareCharsEqual(
+        return CompareCharsEqualWithSimd(
             SeqTwoByteString::cast(string)->GetChars(no_gc, access_guard) +
                 slice_offset,
             data, len);
       case kExternalOneByteStringTag:
-        return CompareCharsEqual(
+        return CompareCharsEqualWithSimd(
             ExternalOneByteString::cast(string)->GetChars() + slice_offset,
             data, len);
       case kExternalTwoByteStringTag:
-        return CompareCharsEqual(
+        return CompareCharsEqualWithSimd(
             ExternalTwoByteString::cast(string)->GetChars() + slice_offset,
             data, len);
 
@@ -1363,15 +1364,18 @@ const uint16_t* ExternalTwoByteString::ExternalTwoByteStringGetData(
   return GetChars() + start;
 }
 
-int ConsStringIterator::OffsetForDepth(int depth) { return depth & kDepthMask; }
+int ConsStringIterator::OffsetForDepth(int depth) const {
+  return depth & (StackSize() - 1);
+}
 
 void ConsStringIterator::PushLeft(Tagged<ConsString> string) {
-  frames_[depth_++ & kDepthMask] = string;
+  if (V8_UNLIKELY(depth_ == StackSize())) GrowStack();
+  frames_[OffsetForDepth(depth_++)] = string;
 }
 
 void ConsStringIterator::PushRight(Tagged<ConsString> string) {
   // Inplace update.
-  frames_[(depth_ - 1) & kDepthMask] = string;
+  frames_[OffsetForDepth(depth_ - 1)] = string;
 }
 
 void ConsStringIterator::AdjustMaximumDepth() {
@@ -65,6 +65,30 @@ class StringTable::OffHeapStringHashSet
     // Do nothing, since the entry size is 1 (just the key).
   }
 
+  // Reserves room for one more element while other threads may be inserting
+  // too. Returns false, without reserving anything, if the table should be
+  // resized first.
+  bool TryReserveElement() {
+    const int number_of_elements =
+        number_of_elements_.fetch_add(1, std::memory_order_relaxed);
+    if (HasSufficientCapacityToAdd(capacity(), number_of_elements,
+                                   number_of_deleted_elements(), 1) &&
+        ComputeCapacityWithShrink(capacity(), number_of_elements + 1) ==
+            capacity()) {
+      return true;
+    }
+    number_of_elements_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Returns the string matching `key`, or inserts the one that `key` creates
+  // into the room reserved by TryReserveElement. Insertions of keys with
+  // hashes in other shards may run concurrently, so entries may change from
+  // empty or deleted to other strings, but never to one that matches `key`.
+  template <typename IsolateT, typename StringTableKey>
+  DirectHandle<String> FindOrInsertReserved(IsolateT* isolate,
+                                            StringTableKey* key);
+
  private:
   friend class StringTable::Data;
 };
@@ -157,6 +181,48 @@ void StringTable::Data::Print(PtrComprCageBase cage_base) const {
   os << "}" << std::endl;
 }
 
+template <typename IsolateT, typename StringTableKey>
+DirectHandle<String> StringTable::OffHeapStringHashSet::FindOrInsertReserved(
+    IsolateT* isolate, StringTableKey* key) {
+  DirectHandle<String> new_string;
+  while (true) {
+    InternalIndex insertion_entry = InternalIndex::NotFound();
+    Tagged<Object> insertion_element;
+    uint32_t count = 1;
+    for (InternalIndex entry = FirstProbe(key->hash(), capacity());;
+         entry = NextProbe(entry, count++, capacity())) {
+      Tagged<Object> element = GetKey(isolate, entry);
+      if (element == empty_element() || element == deleted_element()) {
+        if (insertion_entry.is_not_found()) {
+          insertion_entry = entry;
+          insertion_element = element;
+        }
+        // Continue past deleted entries in case the key is behind them.
+        if (element == empty_element()) break;
+        continue;
+      }
+      if (KeyIsMatch(isolate, key, element)) {
+        number_of_elements_.fetch_sub(1, std::memory_order_relaxed);
+        return direct_handle(String::cast(element), isolate);
+      }
+    }
+
+    if (new_string.is_null()) {
+      new_string = key->GetHandleForInsertion();
+      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
+    }
+    if (slot(insertion_entry)
+            .Release_CompareAndSwap(insertion_element, *new_string) ==
+        insertion_element) {
+      if (insertion_element == deleted_element()) {
+        number_of_deleted_elements_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      return new_string;
+    }
+    // Another insertion took the entry first, so probe again for the next one.
+  }
+}
+
 StringTable::StringTable(Isolate* isolate)
     : data_(Data::New(OffHeapStringHashSet::kMinCapacity).release()),
       isolate_(isolate) {
@@ -171,7 +237,9 @@ int StringTable::Capacity() const {
 }
 int StringTable::NumberOfElements() const {
   {
-    base::MutexGuard table_write_guard(&write_mutex_);
+    // Insertions may have reserved room for elements that they haven't
+    // inserted yet, so wait for them.
+    base::SharedMutexGuard<base::kExclusive> table_guard(&table_mutex_);
     return data_.load(std::memory_order_relaxed)->table().number_of_elements();
   }
 }
@@ -393,8 +461,8 @@ DirectHandle<String> StringTable::LookupKey(IsolateT* isolate,
   //
   //   - The Heap access is allowed to be concurrent (using LocalHeap or
   //     similar),
-  //   - All writes to the string table are guarded by the Isolate string table
-  //     mutex,
+  //   - All writes to the string table hold the table mutex, and all entries
+  //     are written with a compare-and-swap from empty or deleted to a string,
   //   - Resizes of the string table first copies the old contents to the new
   //     table, and only then sets the new string table pointer to the new
   //     table,
@@ -416,6 +484,13 @@ DirectHandle<String> StringTable::LookupKey(IsolateT* isolate,
   // and on a miss we take the lock and try to write the entry, with a second
   // read lookup in case the non-locked read missed a write.
   //
+  // To keep internalization on many threads from serializing on one lock,
+  // writers only hold the table mutex in shared mode, which merely excludes
+  // resizes. Writers of the same string still have to be serialized, so that
+  // only one of them inserts it, and therefore also hold the mutex of the
+  // shard that the string's hash falls into. Writers in different shards may
+  // race for the same empty entry, which the compare-and-swap resolves.
+  //
   // One complication is allocation -- we don't want to allocate while holding
   // the string table lock. This applies to both allocation of new strings, and
   // re-allocation of the string table on resize. So, we optimistically allocate
@@ -443,35 +518,22 @@ DirectHandle<String> StringTable::LookupKey(IsolateT* isolate,
 
   // No entry found, so adding new string.
   key->PrepareForInsertion(isolate);
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-
-    Data* data = EnsureCapacity(isolate, 1);
-    OffHeapStringHashSet& table = data->table();
-
-    // Check one last time if the key is present in the table, in case it was
-    // added after the check.
-    entry = table.FindEntryOrInsertionEntry(isolate, key, key->hash());
-
-    Tagged<Object> element = table.GetKey(isolate, entry);
-    if (element == OffHeapStringHashSet::empty_element()) {
-      // This entry is empty, so write it and register that we added an
-      // element.
-      DirectHandle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      table.AddAt(isolate, entry, *new_string);
-      return new_string;
-    } else if (element == OffHeapStringHashSet::deleted_element()) {
-      // This entry was deleted, so overwrite it and register that we
-      // overwrote a deleted element.
-      DirectHandle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      table.OverwriteDeletedAt(isolate, entry, *new_string);
-      return new_string;
-    } else {
-      // Return the existing string as a handle.
-      return direct_handle(String::cast(element), isolate);
+  base::MutexGuard shard_guard(InsertionMutexFor(key->hash()));
+  while (true) {
+    {
+      base::SharedMutexGuard<base::kShared> table_guard(&table_mutex_);
+      // This load can be relaxed as the table pointer can only be modified
+      // while the mutex is held exclusively.
+      OffHeapStringHashSet& table =
+          data_.load(std::memory_order_relaxed)->table();
+      if (table.TryReserveElement()) {
+        // Check one last time if the key is present in the table, in case it
+        // was added after the check.
+        return table.FindOrInsertReserved(isolate, key);
+      }
     }
+    base::SharedMutexGuard<base::kExclusive> table_guard(&table_mutex_);
+    EnsureCapacity(isolate, 1);
   }
 }
 
@@ -496,11 +558,8 @@ template DirectHandle<String> StringTable::LookupKey(
 
 StringTable::Data* StringTable::EnsureCapacity(PtrComprCageBase cage_base,
                                                int additional_elements) {
-  // This call is only allowed while the write mutex is held.
-  write_mutex_.AssertHeld();
-
-  // This load can be relaxed as the table pointer can only be modified while
-  // the lock is held.
+  // This call is only allowed while the table mutex is held exclusively, so
+  // this load can be relaxed as the table pointer can only be modified then.
   Data* data = data_.load(std::memory_order_relaxed);
 
   int new_capacity;
@@ -676,7 +735,7 @@ void StringTable::InsertForIsolateDeserialization(
 
   const int length = static_cast<int>(strings.size());
   {
-    base::MutexGuard table_write_guard(&write_mutex_);
+    base::SharedMutexGuard<base::kExclusive> table_guard(&table_mutex_);
 
     Data* const data = EnsureCapacity(isolate, length);
 
@@ -698,7 +757,7 @@ void StringTable::InsertForIsolateDeserialization(
 void StringTable::InsertEmptyStringForBootstrapping(Isolate* isolate) {
   DCHECK_EQ(NumberOfElements(), 0);
   {
-    base::MutexGuard table_write_guard(&write_mutex_);
+    base::SharedMutexGuard<base::kExclusive> table_guard(&table_mutex_);
 
     Data* const data = EnsureCapacity(isolate, 1);
 
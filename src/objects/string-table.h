@@ -5,6 +5,7 @@
 #ifndef V8_OBJECTS_STRING_TABLE_H_
 #define V8_OBJECTS_STRING_TABLE_H_
 
+#include "src/base/platform/mutex.h"
 #include "src/common/assert-scope.h"
 #include "src/objects/string.h"
 #include "src/roots/roots.h"
@@ -41,7 +42,9 @@ class StringTableKey {
 class SeqOneByteString;
 
 // StringTable, for internalizing strings. The Lookup methods are designed to be
-// thread-safe, in combination with GC safepoints.
+// thread-safe, in combination with GC safepoints. Lookups of existing strings
+// don't take any locks, and insertions of strings whose hashes fall into
+// different shards don't wait for each other.
 //
 // The string table layout is defined by its Data implementation class, see
 // StringTable::Data for details.
@@ -82,8 +85,8 @@ class V8_EXPORT_PRIVATE StringTable {
   void Print(PtrComprCageBase cage_base) const;
   size_t GetCurrentMemoryUsage() const;
 
-  // The following methods must be called either while holding the write lock,
-  // or while in a Heap safepoint.
+  // The following methods must be called either while holding the table lock
+  // exclusively, or while in a Heap safepoint.
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
@@ -94,12 +97,28 @@ class V8_EXPORT_PRIVATE StringTable {
   class OffHeapStringHashSet;
   class Data;
 
+  // Insertions lock the shard of their key's hash, so that concurrent
+  // insertions of the same string are serialized.
+  static constexpr int kInsertionShardCount = 16;
+
+  struct alignas(PROCESSOR_CACHE_LINE_SIZE) InsertionShard {
+    base::Mutex mutex;
+  };
+
+  base::Mutex* InsertionMutexFor(uint32_t hash) {
+    return &insertion_shards_[hash % kInsertionShardCount].mutex;
+  }
+
   Data* EnsureCapacity(PtrComprCageBase cage_base, int additional_elements);
 
   std::atomic<Data*> data_;
-  // Write mutex is mutable so that readers of concurrently mutated values (e.g.
-  // NumberOfElements) are allowed to lock it while staying const.
-  mutable base::Mutex write_mutex_;
+  // Insertions hold the table mutex in shared mode, which keeps the table from
+  // being resized under them. Resizes and other writes that need the table to
+  // themselves hold it exclusively. It is mutable so that readers of
+  // concurrently mutated values (e.g. NumberOfElements) are allowed to lock it
+  // while staying const.
+  mutable base::SharedMutex table_mutex_;
+  InsertionShard insertion_shards_[kInsertionShardCount];
   Isolate* isolate_;
 };
 
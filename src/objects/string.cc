@@ -25,6 +25,7 @@
 #include "src/strings/string-builder-inl.h"
 #include "src/strings/string-hasher.h"
 #include "src/strings/string-search.h"
+#include "src/strings/string-simd.h"
 #include "src/strings/string-stream.h"
 #include "src/strings/unicode-inl.h"
 #include "src/utils/ostreams.h"
@@ -1200,15 +1201,40 @@ bool String::SlowEquals(Isolate* isolate, Handle<String> one,
     return CompareCharsEqual(flat1.ToUC16Vector().begin(),
                              flat2.ToUC16Vector().begin(), one_length);
   } else if (flat1.IsOneByte() && flat2.IsTwoByte()) {
-    return CompareCharsEqual(flat1.ToOneByteVector().begin(),
-                             flat2.ToUC16Vector().begin(), one_length);
+    return CompareCharsEqualWithSimd(flat1.ToOneByteVector().begin(),
+                                     flat2.ToUC16Vector().begin(), one_length);
   } else if (flat1.IsTwoByte() && flat2.IsOneByte()) {
-    return CompareCharsEqual(flat1.ToUC16Vector().begin(),
-                             flat2.ToOneByteVector().begin(), one_length);
+    return CompareCharsEqualWithSimd(flat1.ToUC16Vector().begin(),
+                                     flat2.ToOneByteVector().begin(),
+                                     one_length);
   }
   UNREACHABLE();
 }
 
+namespace {
+
+// Comparing a cons string segment by segment first walks down to its leftmost
+// segment. Strings that are deeper than this are flattened instead, so that
+// repeated comparisons, e.g. in Array.prototype.sort, only pay for that once.
+// This matches the frames that ConsStringIterator keeps without allocating.
+constexpr int kMaxConsDepthToCompareUnflattened = 32;
+
+bool IsDeepConsString(Tagged<String> string) {
+  int depth = 0;
+  while (true) {
+    if (IsThinString(string)) {
+      string = ThinString::cast(string)->actual();
+    } else if (IsConsString(string)) {
+      if (++depth > kMaxConsDepthToCompareUnflattened) return true;
+      string = ConsString::cast(string)->first();
+    } else {
+      return false;
+    }
+  }
+}
+
+}  // namespace
+
 // static
 ComparisonResult String::Compare(Isolate* isolate, Handle<String> x,
                                  Handle<String> y) {
@@ -1222,6 +1248,9 @@ ComparisonResult String::Compare(Isolate* isolate, Handle<String> x,
     return ComparisonResult::kLessThan;
   }
 
+  if (IsDeepConsString(*x)) x = String::Flatten(isolate, x);
+  if (IsDeepConsString(*y)) y = String::Flatten(isolate, y);
+
   int const d = x->Get(0) - y->Get(0);
   if (d < 0) {
     return ComparisonResult::kLessThan;
@@ -1229,47 +1258,12 @@ ComparisonResult String::Compare(Isolate* isolate, Handle<String> x,
     return ComparisonResult::kGreaterThan;
   }
 
-  // Slow case.
-  x = String::Flatten(isolate, x);
-  y = String::Flatten(isolate, y);
-
+  // Slow case. Compare the strings segment by segment, so that shallow cons
+  // strings don't have to be flattened. Comparisons usually stop long before
+  // the end of the strings.
   DisallowGarbageCollection no_gc;
-  ComparisonResult result = ComparisonResult::kEqual;
-  int prefix_length = x->length();
-  if (y->length() < prefix_length) {
-    prefix_length = y->length();
-    result = ComparisonResult::kGreaterThan;
-  } else if (y->length() > prefix_length) {
-    result = ComparisonResult::kLessThan;
-  }
-  int r;
-  String::FlatContent x_content = x->GetFlatContent(no_gc);
-  String::FlatContent y_content = y->GetFlatContent(no_gc);
-  if (x_content.IsOneByte()) {
-    base::Vector<const uint8_t> x_chars = x_content.ToOneByteVector();
-    if (y_content.IsOneByte()) {
-      base::Vector<const uint8_t> y_chars = y_content.ToOneByteVector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
-    } else {
-      base::Vector<const base::uc16> y_chars = y_content.ToUC16Vector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
-    }
-  } else {
-    base::Vector<const base::uc16> x_chars = x_content.ToUC16Vector();
-    if (y_content.IsOneByte()) {
-      base::Vector<const uint8_t> y_chars = y_content.ToOneByteVector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
-    } else {
-      base::Vector<const base::uc16> y_chars = y_content.ToUC16Vector();
-      r = CompareChars(x_chars.begin(), y_chars.begin(), prefix_length);
-    }
-  }
-  if (r < 0) {
-    result = ComparisonResult::kLessThan;
-  } else if (r > 0) {
-    result = ComparisonResult::kGreaterThan;
-  }
-  return result;
+  StringComparator comparator;
+  return comparator.Compare(*x, *y, SharedStringAccessGuardIfNeeded(isolate));
 }
 
 namespace {
@@ -1938,10 +1932,18 @@ void ConsStringIterator::Initialize(Tagged<ConsString> cons_string,
   consumed_ = offset;
   // Force stack blown condition to trigger restart.
   depth_ = 1;
-  maximum_depth_ = kStackSize + depth_;
+  maximum_depth_ = StackSize() + depth_;
   DCHECK(StackBlown());
 }
 
+void ConsStringIterator::GrowStack() {
+  if (StackSize() == kMaxStackSize) return;
+  // The stack grows as soon as it is full, so no frames have wrapped around
+  // yet and they stay at their offsets.
+  DCHECK_LE(maximum_depth_, StackSize());
+  frames_.resize_no_init(2 * StackSize());
+}
+
 Tagged<String> ConsStringIterator::Continue(int* offset_out) {
   DCHECK_NE(depth_, 0);
   DCHECK_EQ(0, *offset_out);
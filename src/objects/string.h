@@ -19,6 +19,7 @@
 #include "src/objects/smi.h"
 #include "src/objects/tagged.h"
 #include "src/sandbox/external-pointer.h"
+#include "src/strings/string-simd.h"
 #include "src/strings/unicode-decoder.h"
 
 // Has to be the last include (doesn't have include guards):
@@ -533,6 +534,9 @@ V8_OBJECT class String : public Name {
 
   static inline int NonOneByteStart(const base::uc16* chars, int length) {
     DCHECK(IsAligned(reinterpret_cast<Address>(chars), sizeof(base::uc16)));
+    if (StringSimd::IsEnabledFor(length)) {
+      return static_cast<int>(StringSimd::NonOneByteStart(chars, length));
+    }
     const uint16_t* start = chars;
     const uint16_t* limit = chars + length;
 
@@ -1239,9 +1243,10 @@ class V8_EXPORT_PRIVATE FlatStringReader : public Relocatable {
 // traversal of the entire string
 class ConsStringIterator {
  public:
-  inline ConsStringIterator() = default;
+  inline ConsStringIterator() : frames_(kInitialStackSize) {}
   inline explicit ConsStringIterator(Tagged<ConsString> cons_string,
-                                     int offset = 0) {
+                                     int offset = 0)
+      : frames_(kInitialStackSize) {
     Reset(cons_string, offset);
   }
   ConsStringIterator(const ConsStringIterator&) = delete;
@@ -1264,18 +1269,27 @@ class ConsStringIterator {
   }
 
  private:
-  static const int kStackSize = 32;
+  // The stack starts out with room for kInitialStackSize frames, which is
+  // plenty for balanced trees. For deeper trees, such as the left-leaning ones
+  // that repeated appends build, it grows up to kMaxStackSize frames. Only
+  // beyond that do frames wrap around, and the traversal has to restart from
+  // the root whenever it runs out of frames.
+  static const int kInitialStackSize = 32;
+  static const int kMaxStackSize = 64 * KB;
+  static_assert(base::bits::IsPowerOfTwo(kInitialStackSize),
+                "kInitialStackSize must be power of two");
+  static_assert(base::bits::IsPowerOfTwo(kMaxStackSize),
+                "kMaxStackSize must be power of two");
+  int StackSize() const { return static_cast<int>(frames_.size()); }
   // Use a mask instead of doing modulo operations for stack wrapping.
-  static const int kDepthMask = kStackSize - 1;
-  static_assert(base::bits::IsPowerOfTwo(kStackSize),
-                "kStackSize must be power of two");
-  static inline int OffsetForDepth(int depth);
+  inline int OffsetForDepth(int depth) const;
 
   inline void PushLeft(Tagged<ConsString> string);
   inline void PushRight(Tagged<ConsString> string);
   inline void AdjustMaximumDepth();
   inline void Pop();
-  inline bool StackBlown() { return maximum_depth_ - depth_ == kStackSize; }
+  inline bool StackBlown() { return maximum_depth_ - depth_ == StackSize(); }
+  V8_EXPORT_PRIVATE void GrowStack();
   V8_EXPORT_PRIVATE void Initialize(Tagged<ConsString> cons_string, int offset);
   V8_EXPORT_PRIVATE Tagged<String> Continue(int* offset_out);
   Tagged<String> NextLeaf(bool* blew_stack);
@@ -1283,7 +1297,7 @@ class ConsStringIterator {
 
   // Stack must always contain only frames for which right traversal
   // has not yet been performed.
-  Tagged<ConsString> frames_[kStackSize];
+  base::SmallVector<Tagged<ConsString>, kInitialStackSize> frames_;
   Tagged<ConsString> root_;
   int depth_;
   int maximum_depth_;
@@ -4,10 +4,13 @@
 
 #include "src/regexp/experimental/experimental-interpreter.h"
 
+#include "src/base/functional.h"
 #include "src/base/optional.h"
 #include "src/base/strings.h"
 #include "src/common/assert-scope.h"
+#include "src/flags/flags.h"
 #include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-regexp.h"
 #include "src/objects/string-inl.h"
 #include "src/regexp/experimental/experimental.h"
 #include "src/strings/char-predicates-inl.h"
@@ -86,6 +89,385 @@ base::Vector<const base::uc16> ToCharacterVector<base::uc16>(
   return content.ToUC16Vector();
 }
 
+// A lazily built deterministic automaton that simulates `NfaInterpreter` on
+// the main expression of a bytecode program, but without registers. A DFA state
+// is the priority-ordered list of pcs at which the interpreter's threads block
+// on a CONSUME_RANGE instruction after some input, and whether one of its
+// threads ACCEPTed on the way there. Running the DFA thus finds where the match
+// reported by the interpreter ends, at the cost of one table lookup per input
+// character.
+//
+// States and transitions are only computed once the input reaches them, and
+// only up to `kMemoryBudget` bytes are spent on them; the caller falls back to
+// the interpreter if that doesn't suffice.
+//
+// To find where the match begins, the automaton of the main expression is also
+// simulated backwards, starting from the end of the match. This ignores thread
+// priorities, but the match reported by the interpreter begins at the leftmost
+// position at which any match begins, so that's the last position at which the
+// backward simulation passes the start of the main expression.
+//
+// Assertions and lookbehinds depend on the input around the current position,
+// so programs that contain them are not supported.
+class LazyDfa {
+ public:
+  struct State {
+    // The pcs of the blocked threads, sorted from high to low priority.
+    base::Vector<const int> pcs;
+    // Whether a thread ACCEPTed on the way to this state.
+    bool is_match;
+    // The successor state for each character class, or nullptr if it hasn't
+    // been computed yet.
+    State** next;
+  };
+
+  static bool CanBeUsed(base::Vector<const RegExpInstruction> bytecode) {
+    for (const RegExpInstruction& inst : bytecode) {
+      switch (inst.opcode) {
+        case RegExpInstruction::ASSERTION:
+        case RegExpInstruction::WRITE_LOOKBEHIND_TABLE:
+        case RegExpInstruction::READ_LOOKBEHIND_TABLE:
+          return false;
+        default:
+          break;
+      }
+    }
+    return true;
+  }
+
+  LazyDfa(base::Vector<const RegExpInstruction> bytecode, Zone* zone)
+      : code_(zone->CloneVector(bytecode)),
+        states_(zone),
+        class_boundaries_(zone),
+        visited_(2 * bytecode.size(), 0, zone),
+        blocked_(bytecode.size(), 0, zone),
+        stack_(zone),
+        pcs_(zone),
+        predecessor_offsets_(bytecode.size() + 1, 0, zone),
+        predecessors_(zone),
+        backward_marks_(bytecode.size(), 0, zone),
+        backward_pcs_(zone),
+        next_backward_pcs_(zone),
+        zone_(zone) {
+    DCHECK(CanBeUsed(bytecode));
+    const int length = static_cast<int>(code_.size());
+
+    // Partition the characters into classes that no CONSUME_RANGE instruction
+    // can tell apart.
+    for (const RegExpInstruction& inst : code_) {
+      if (inst.opcode != RegExpInstruction::CONSUME_RANGE) continue;
+      class_boundaries_.push_back(inst.payload.consume_range.min);
+      class_boundaries_.push_back(inst.payload.consume_range.max + 1);
+    }
+    std::sort(class_boundaries_.begin(), class_boundaries_.end());
+    class_boundaries_.erase(
+        std::unique(class_boundaries_.begin(), class_boundaries_.end()),
+        class_boundaries_.end());
+    class_count_ = static_cast<int>(class_boundaries_.size()) + 1;
+    for (int c = 0; c <= String::kMaxOneByteCharCode; ++c) {
+      latin1_classes_[c] = ComputeClass(c);
+    }
+
+    // The main expression starts at the instruction that records the begin of
+    // the match and ends at its ACCEPT. Lookbehinds are not supported, so
+    // there is only one ACCEPT.
+    for (int pc = 0; pc < length; ++pc) {
+      const RegExpInstruction& inst = code_[pc];
+      if (inst.opcode == RegExpInstruction::SET_REGISTER_TO_CP &&
+          inst.payload.register_index == 0 && entry_pc_ == -1) {
+        entry_pc_ = pc;
+      } else if (inst.opcode == RegExpInstruction::ACCEPT) {
+        DCHECK_EQ(accept_pc_, -1);
+        accept_pc_ = pc;
+      }
+    }
+    DCHECK_NE(entry_pc_, -1);
+    DCHECK_NE(accept_pc_, -1);
+
+    // Collect the predecessors along instructions that don't consume input,
+    // for the backward simulation.
+    auto for_each_successor = [&](int pc, auto&& f) {
+      const RegExpInstruction& inst = code_[pc];
+      switch (inst.opcode) {
+        case RegExpInstruction::FORK:
+          f(pc + 1);
+          f(inst.payload.pc);
+          break;
+        case RegExpInstruction::JMP:
+          f(inst.payload.pc);
+          break;
+        case RegExpInstruction::SET_REGISTER_TO_CP:
+        case RegExpInstruction::CLEAR_REGISTER:
+        case RegExpInstruction::BEGIN_LOOP:
+        case RegExpInstruction::END_LOOP:
+          f(pc + 1);
+          break;
+        default:
+          break;
+      }
+    };
+    for (int pc = 0; pc < length; ++pc) {
+      for_each_successor(pc, [&](int succ) {
+        SBXCHECK_GE(succ, 0);
+        SBXCHECK_LT(succ, length);
+        ++predecessor_offsets_[succ + 1];
+      });
+    }
+    for (int pc = 0; pc < length; ++pc) {
+      predecessor_offsets_[pc + 1] += predecessor_offsets_[pc];
+    }
+    predecessors_.resize(predecessor_offsets_[length]);
+    ZoneVector<int> next_predecessor(predecessor_offsets_.begin(),
+                                     predecessor_offsets_.end() - 1, zone);
+    for (int pc = 0; pc < length; ++pc) {
+      for_each_successor(pc, [&](int succ) {
+        predecessors_[next_predecessor[succ]++] = pc;
+      });
+    }
+  }
+
+  // Returns the state at the position where the search starts, or nullptr if
+  // the memory budget is exhausted.
+  State* Start() {
+    if (start_ == nullptr) {
+      DCHECK(stack_.empty());
+      stack_.push_back(Thread{0, true});
+      start_ = RunThreads();
+    }
+    return start_;
+  }
+
+  // Returns the state after consuming `input_char` in `state`, or nullptr if
+  // the memory budget is exhausted.
+  State* Next(State* state, base::uc16 input_char) {
+    const int character_class = ClassOf(input_char);
+    State* next = state->next[character_class];
+    if (next != nullptr) return next;
+
+    // Threads are run from high to low priority, so the highest priority
+    // thread goes to the back of the stack.
+    DCHECK(stack_.empty());
+    for (int i = state->pcs.length() - 1; i >= 0; --i) {
+      const int pc = state->pcs[i];
+      RegExpInstruction::Uc16Range range = code_[pc].payload.consume_range;
+      if (input_char >= range.min && input_char <= range.max) {
+        stack_.push_back(Thread{pc + 1, true});
+      }
+    }
+    next = RunThreads();
+    if (next != nullptr) state->next[character_class] = next;
+    return next;
+  }
+
+  // Starts the backward simulation at the end of a match.
+  void StartBackward() {
+    ++backward_epoch_;
+    backward_pcs_.clear();
+    backward_marks_[accept_pc_] = backward_epoch_;
+    backward_pcs_.push_back(accept_pc_);
+    CloseBackward();
+  }
+
+  // Moves the backward simulation to the position before `input_char`.
+  void StepBackward(base::uc16 input_char) {
+    ++backward_epoch_;
+    next_backward_pcs_.clear();
+    for (int pc : backward_pcs_) {
+      if (pc == 0) continue;
+      const RegExpInstruction& inst = code_[pc - 1];
+      if (inst.opcode != RegExpInstruction::CONSUME_RANGE) continue;
+      RegExpInstruction::Uc16Range range = inst.payload.consume_range;
+      if (input_char < range.min || input_char > range.max) continue;
+      if (backward_marks_[pc - 1] == backward_epoch_) continue;
+      backward_marks_[pc - 1] = backward_epoch_;
+      next_backward_pcs_.push_back(pc - 1);
+    }
+    backward_pcs_.swap(next_backward_pcs_);
+    CloseBackward();
+  }
+
+  // Whether a match that ends where the backward simulation started can begin
+  // at the current position.
+  bool BackwardReachedEntry() const {
+    return backward_marks_[entry_pc_] == backward_epoch_;
+  }
+  bool BackwardIsEmpty() const { return backward_pcs_.empty(); }
+
+ private:
+  struct Thread {
+    int pc;
+    bool consumed_since_last_quantifier;
+  };
+
+  struct StateHash {
+    size_t operator()(const State* state) const {
+      return base::hash_combine(
+          base::hash_range(state->pcs.begin(), state->pcs.end()),
+          state->is_match);
+    }
+  };
+  struct StateEqual {
+    bool operator()(const State* a, const State* b) const {
+      return a->is_match == b->is_match && a->pcs == b->pcs;
+    }
+  };
+
+  // DFA states and transitions take at most this many bytes.
+  static constexpr size_t kMemoryBudget = 256 * KB;
+
+  int ComputeClass(base::uc16 c) const {
+    return static_cast<int>(std::upper_bound(class_boundaries_.begin(),
+                                             class_boundaries_.end(), c) -
+                            class_boundaries_.begin());
+  }
+
+  int ClassOf(base::uc16 c) const {
+    if (c <= String::kMaxOneByteCharCode) return latin1_classes_[c];
+    return ComputeClass(c);
+  }
+
+  // Runs the threads on `stack_` like `NfaInterpreter::RunActiveThreads`, and
+  // returns the state made up of the threads that block, or nullptr if the
+  // memory budget is exhausted.
+  State* RunThreads() {
+    ++epoch_;
+    pcs_.clear();
+    bool is_match = false;
+    while (!stack_.empty()) {
+      Thread t = stack_.back();
+      stack_.pop_back();
+      RunThread(t, &is_match);
+    }
+    return FindOrAddState(is_match);
+  }
+
+  void RunThread(Thread t, bool* is_match) {
+    while (true) {
+      SBXCHECK_GE(t.pc, 0);
+      SBXCHECK_LT(t.pc, static_cast<int>(code_.size()));
+      uint32_t& visited =
+          visited_[2 * t.pc + (t.consumed_since_last_quantifier ? 1 : 0)];
+      if (visited == epoch_) return;
+      visited = epoch_;
+
+      const RegExpInstruction& inst = code_[t.pc];
+      switch (inst.opcode) {
+        case RegExpInstruction::CONSUME_RANGE:
+          // Blocked threads only differ in whether they consumed a character
+          // since the last quantifier, which they all do once they continue.
+          // Only the one with the highest priority is relevant.
+          if (blocked_[t.pc] != epoch_) {
+            blocked_[t.pc] = epoch_;
+            pcs_.push_back(t.pc);
+          }
+          return;
+        case RegExpInstruction::FORK:
+          stack_.push_back(
+              Thread{inst.payload.pc, t.consumed_since_last_quantifier});
+          ++t.pc;
+          break;
+        case RegExpInstruction::JMP:
+          t.pc = inst.payload.pc;
+          break;
+        case RegExpInstruction::ACCEPT:
+          // Threads with lower priority can't produce a better match.
+          *is_match = true;
+          stack_.clear();
+          return;
+        case RegExpInstruction::SET_REGISTER_TO_CP:
+        case RegExpInstruction::CLEAR_REGISTER:
+          ++t.pc;
+          break;
+        case RegExpInstruction::BEGIN_LOOP:
+          t.consumed_since_last_quantifier = false;
+          ++t.pc;
+          break;
+        case RegExpInstruction::END_LOOP:
+          if (!t.consumed_since_last_quantifier) return;
+          ++t.pc;
+          break;
+        case RegExpInstruction::ASSERTION:
+        case RegExpInstruction::WRITE_LOOKBEHIND_TABLE:
+        case RegExpInstruction::READ_LOOKBEHIND_TABLE:
+          UNREACHABLE();
+      }
+    }
+  }
+
+  State* FindOrAddState(bool is_match) {
+    State key{base::VectorOf(pcs_), is_match, nullptr};
+    auto it = states_.find(&key);
+    if (it != states_.end()) return *it;
+
+    const size_t size = sizeof(State) + pcs_.size() * sizeof(int) +
+                        class_count_ * sizeof(State*);
+    if (memory_used_ + size > kMemoryBudget) return nullptr;
+    memory_used_ += size;
+
+    State* state = zone_->New<State>();
+    state->pcs = zone_->CloneVector(base::VectorOf(pcs_));
+    state->is_match = is_match;
+    state->next = zone_->AllocateArray<State*>(class_count_);
+    std::fill_n(state->next, class_count_, nullptr);
+    states_.insert(state);
+    return state;
+  }
+
+  // Adds all pcs from which the pcs in `backward_pcs_` can be reached without
+  // consuming input. The search doesn't continue before the start of the main
+  // expression.
+  void CloseBackward() {
+    for (size_t i = 0; i < backward_pcs_.size(); ++i) {
+      const int pc = backward_pcs_[i];
+      if (pc == entry_pc_) continue;
+      for (int j = predecessor_offsets_[pc]; j < predecessor_offsets_[pc + 1];
+           ++j) {
+        const int predecessor = predecessors_[j];
+        if (backward_marks_[predecessor] == backward_epoch_) continue;
+        backward_marks_[predecessor] = backward_epoch_;
+        backward_pcs_.push_back(predecessor);
+      }
+    }
+  }
+
+  const base::Vector<RegExpInstruction> code_;
+
+  ZoneUnorderedSet<State*, StateHash, StateEqual> states_;
+  State* start_ = nullptr;
+  size_t memory_used_ = 0;
+
+  // Sorted start points of the character classes.
+  ZoneVector<int> class_boundaries_;
+  int class_count_;
+  int latin1_classes_[String::kMaxOneByteCharCode + 1];
+
+  // Scratch data for computing a state. A thread at pc with and without a
+  // consumed character has been run if `visited_[2 * pc + 1]` and
+  // `visited_[2 * pc]` are equal to `epoch_`, and has blocked at pc if
+  // `blocked_[pc]` is.
+  uint32_t epoch_ = 0;
+  ZoneVector<uint32_t> visited_;
+  ZoneVector<uint32_t> blocked_;
+  ZoneVector<Thread> stack_;
+  ZoneVector<int> pcs_;
+
+  // The predecessors of pc are `predecessors_[j]` for
+  // `predecessor_offsets_[pc] <= j < predecessor_offsets_[pc + 1]`.
+  ZoneVector<int> predecessor_offsets_;
+  ZoneVector<int> predecessors_;
+  int entry_pc_ = -1;
+  int accept_pc_ = -1;
+
+  // The pcs of the backward simulation at the current position, which are
+  // exactly those whose mark is equal to `backward_epoch_`.
+  uint32_t backward_epoch_ = 0;
+  ZoneVector<uint32_t> backward_marks_;
+  ZoneVector<int> backward_pcs_;
+  ZoneVector<int> next_backward_pcs_;
+
+  Zone* zone_;
+};
+
 template <class Character>
 class NfaInterpreter {
   // Executes a bytecode program in breadth-first mode, without backtracking.
@@ -177,6 +559,11 @@ class NfaInterpreter {
 
     std::fill(pc_last_input_index_.begin(), pc_last_input_index_.end(),
               LastInputIndex());
+
+    if (v8_flags.experimental_regexp_engine_dfa &&
+        LazyDfa::CanBeUsed(bytecode_)) {
+      dfa_ = zone->New<LazyDfa>(bytecode_, zone);
+    }
   }
 
   // Finds matches and writes their concatenated capture registers to
@@ -189,7 +576,8 @@ class NfaInterpreter {
 
     int match_num = 0;
     while (match_num != max_match_num) {
-      int err_code = FindNextMatch();
+      int err_code =
+          dfa_ != nullptr ? FindNextMatchWithDfa() : FindNextMatch();
       if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
 
       if (!FoundMatch()) break;
@@ -398,7 +786,6 @@ class NfaInterpreter {
 
       std::fill(lookbehind_table_.begin(), lookbehind_table_.end(), false);
 
-      static constexpr int kTicksBetweenInterruptHandling = 64;
       if (input_index_ % kTicksBetweenInterruptHandling == 0) {
         int err_code = HandleInterrupts();
         if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
@@ -414,6 +801,76 @@ class NfaInterpreter {
     return RegExp::kInternalRegExpSuccess;
   }
 
+  // Like `FindNextMatch`, but finds the boundaries of the match with `dfa_`.
+  // The threads are only run to find the captures, and then start at the
+  // beginning of the match.
+  int FindNextMatchWithDfa() {
+    DCHECK_NOT_NULL(dfa_);
+    if (best_match_registers_.has_value()) {
+      FreeRegisterArray(best_match_registers_->begin());
+      best_match_registers_ = base::nullopt;
+    }
+
+    int match_end = -1;
+    LazyDfa::State* state = dfa_->Start();
+    int index = input_index_;
+    while (state != nullptr) {
+      if (state->is_match) match_end = index;
+      if (index == input_.length() || state->pcs.empty()) break;
+      base::uc16 input_char = input_[index];
+      ++index;
+
+      if (index % kTicksBetweenInterruptHandling == 0) {
+        int err_code = HandleInterrupts();
+        if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
+      }
+
+      state = dfa_->Next(state, input_char);
+    }
+    if (state == nullptr) {
+      // The DFA exceeded its memory budget, so we run the threads from now on.
+      dfa_ = nullptr;
+      return FindNextMatch();
+    }
+    if (match_end == -1) return RegExp::kInternalRegExpSuccess;
+
+    int match_begin = -1;
+    dfa_->StartBackward();
+    index = match_end;
+    while (true) {
+      if (dfa_->BackwardReachedEntry()) match_begin = index;
+      if (index == input_index_ || dfa_->BackwardIsEmpty()) break;
+      --index;
+      base::uc16 input_char = input_[index];
+
+      if (index % kTicksBetweenInterruptHandling == 0) {
+        int err_code = HandleInterrupts();
+        if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
+      }
+
+      dfa_->StepBackward(input_char);
+    }
+    DCHECK_NE(match_begin, -1);
+
+    if (register_count_per_match_ == JSRegExp::RegistersForCaptureCount(0)) {
+      int* registers = NewRegisterArrayUninitialized();
+      registers[0] = match_begin;
+      registers[1] = match_end;
+      best_match_registers_ =
+          base::Vector<int>(registers, register_count_per_match_);
+      return RegExp::kInternalRegExpSuccess;
+    }
+
+    // No match begins before `match_begin`, so the threads started there find
+    // the same match.
+    SetInputIndex(match_begin);
+    int err_code = FindNextMatch();
+    DCHECK_IMPLIES(err_code == RegExp::kInternalRegExpSuccess,
+                   FoundMatch() && (*best_match_registers_)[0] == match_begin &&
+                       (*best_match_registers_)[1] == match_end);
+    return err_code;
+  }
+
   // Run an active thread `t` until it executes a CONSUME_RANGE or ACCEPT
   // instruction, or its PC value was already processed.
   // - If processing of `t` can't continue because of CONSUME_RANGE, it is
@@ -638,6 +1095,8 @@ class NfaInterpreter {
     }
   }
 
+  static constexpr int kTicksBetweenInterruptHandling = 64;
+
   Isolate* const isolate_;
 
   const RegExp::CallOrigin call_origin_;
@@ -702,6 +1161,10 @@ class NfaInterpreter {
   // lookbehind of index k did complete a match on the current position.
   ZoneList<bool> lookbehind_table_;
 
+  // Finds the boundaries of matches if the bytecode program allows, see
+  // `FindNextMatchWithDfa`.
+  LazyDfa* dfa_ = nullptr;
+
   Zone* zone_;
 };
 
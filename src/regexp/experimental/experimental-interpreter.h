@@ -22,7 +22,9 @@ class ExperimentalRegExpInterpreter final : public AllStatic {
   // `max_match_num` matches in `input`, starting at `start_index`.  Returns
   // the actual number of matches found.  The boundaries of matching subranges
   // are written to `matches_out`.  Provided in variants for one-byte and
-  // two-byte strings.
+  // two-byte strings.  Unless the program contains assertions or lookbehinds,
+  // the boundaries are found with a lazily built DFA, and the NFA only runs to
+  // find the captures.
   static int FindMatches(Isolate* isolate, RegExp::CallOrigin call_origin,
                          Tagged<ByteArray> bytecode, int capture_count,
                          Tagged<String> input, int start_index,
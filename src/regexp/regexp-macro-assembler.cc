@@ -12,6 +12,7 @@
 #include "src/regexp/regexp-stack.h"
 #include "src/regexp/special-case.h"
 #include "src/strings/unicode-inl.h"
+#include "src/utils/ostreams.h"
 
 #ifdef V8_INTL_SUPPORT
 #include "unicode/uchar.h"
@@ -433,6 +434,7 @@ int NativeRegExpMacroAssembler::Execute(
     int start_offset, const uint8_t* input_start, const uint8_t* input_end,
     int* output, int output_size, Isolate* isolate, Tagged<JSRegExp> regexp) {
   RegExpStackScope stack_scope(isolate);
+  const size_t old_stack_size = stack_scope.stack()->memory_size();
 
   bool is_one_byte = String::IsOneByteRepresentationUnderneath(input);
   Tagged<Code> code = Code::cast(regexp->code(isolate, is_one_byte));
@@ -449,6 +451,14 @@ int NativeRegExpMacroAssembler::Execute(
                        output, output_size, call_origin, isolate, regexp.ptr());
   DCHECK_GE(result, SMALLEST_REGEXP_RESULT);
 
+  if (V8_UNLIKELY(v8_flags.trace_regexp_stack) &&
+      stack_scope.stack()->memory_size() > old_stack_size) {
+    StdoutStream{} << "RegExp " << regexp->source()
+                   << " grew the backtrack stack to "
+                   << stack_scope.stack()->memory_size() << " bytes"
+                   << std::endl;
+  }
+
   if (result == EXCEPTION && !isolate->has_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
     // but haven't created the exception yet. Additionally, we allow heap
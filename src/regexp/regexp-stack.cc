@@ -5,19 +5,28 @@
 #include "src/regexp/regexp-stack.h"
 
 #include "src/execution/isolate.h"
+#include "src/logging/counters.h"
+#include "src/utils/allocation.h"
 #include "src/utils/memcopy.h"
 
 namespace v8 {
 namespace internal {
 
 RegExpStackScope::RegExpStackScope(Isolate* isolate)
-    : regexp_stack_(isolate->regexp_stack()),
+    : isolate_(isolate),
+      regexp_stack_(isolate->regexp_stack()),
       old_sp_top_delta_(regexp_stack_->sp_top_delta()) {
   DCHECK(regexp_stack_->IsValid());
 }
 
 RegExpStackScope::~RegExpStackScope() {
   CHECK_EQ(old_sp_top_delta_, regexp_stack_->sp_top_delta());
+  if (regexp_stack_->IsDynamicAndEmpty()) {
+    // The dynamic stack only grows until it is reset, so its size is the
+    // high-water mark of the executions since the static stack was left.
+    isolate_->counters()->regexp_stack_high_water_mark()->AddSample(
+        static_cast<int>(regexp_stack_->memory_size() / KB));
+  }
   regexp_stack_->ResetIfEmpty();
 }
 
@@ -42,12 +51,21 @@ char* RegExpStack::ArchiveStack(char* to) {
 
 
 char* RegExpStack::RestoreStack(char* from) {
+  thread_local_.FreeAndInvalidate();
   MemCopy(&thread_local_, reinterpret_cast<void*>(from), kThreadLocalSize);
   return from + kThreadLocalSize;
 }
 
 void RegExpStack::ThreadLocal::ResetToStaticStack(RegExpStack* regexp_stack) {
-  if (owns_memory_) DeleteArray(memory_);
+  if (owns_memory_ && !IsInReservation()) DeleteArray(memory_);
+  if (committed_size_ > kRetainedStackSize) {
+    // Decommit all but the top of the reserved region.
+    uint8_t* reservation_top = reservation_ + kReservationSize;
+    CHECK(GetPlatformPageAllocator()->DecommitPages(
+        reservation_top - committed_size_,
+        committed_size_ - kRetainedStackSize));
+    committed_size_ = kRetainedStackSize;
+  }
 
   memory_ = regexp_stack->static_stack_;
   memory_top_ = regexp_stack->static_stack_ + kStaticStackSize;
@@ -59,7 +77,10 @@ void RegExpStack::ThreadLocal::ResetToStaticStack(RegExpStack* regexp_stack) {
 }
 
 void RegExpStack::ThreadLocal::FreeAndInvalidate() {
-  if (owns_memory_) DeleteArray(memory_);
+  if (owns_memory_ && !IsInReservation()) DeleteArray(memory_);
+  if (reservation_ != nullptr) {
+    FreePages(GetPlatformPageAllocator(), reservation_, kReservationSize);
+  }
 
   // This stack may not be used after being freed. Just reset to invalid values
   // to ensure we don't accidentally use old memory areas.
@@ -68,31 +89,88 @@ void RegExpStack::ThreadLocal::FreeAndInvalidate() {
   memory_size_ = 0;
   stack_pointer_ = nullptr;
   limit_ = kMemoryTop;
+  owns_memory_ = false;
+  reservation_ = nullptr;
+  committed_size_ = 0;
 }
 
 Address RegExpStack::EnsureCapacity(size_t size) {
   if (size > kMaximumStackSize) return kNullAddress;
   if (thread_local_.memory_size_ < size) {
     if (size < kMinimumDynamicStackSize) size = kMinimumDynamicStackSize;
-    uint8_t* new_memory = NewArray<uint8_t>(size);
-    if (thread_local_.memory_size_ > 0) {
-      // Copy original memory into top of new memory.
-      MemCopy(new_memory + size - thread_local_.memory_size_,
-              thread_local_.memory_, thread_local_.memory_size_);
-      if (thread_local_.owns_memory_) DeleteArray(thread_local_.memory_);
-    }
-    ptrdiff_t delta = sp_top_delta();
-    thread_local_.memory_ = new_memory;
-    thread_local_.memory_top_ = new_memory + size;
-    thread_local_.memory_size_ = size;
-    thread_local_.stack_pointer_ = thread_local_.memory_top_ + delta;
-    thread_local_.limit_ = reinterpret_cast<Address>(new_memory) +
-                           kStackLimitSlack * kSystemPointerSize;
-    thread_local_.owns_memory_ = true;
+    if (!GrowInReservation(size)) GrowOnHeap(size);
   }
   return reinterpret_cast<Address>(thread_local_.memory_top_);
 }
 
+bool RegExpStack::GrowInReservation(size_t size) {
+  if (size > kReservationSize) return false;
+  // Once the stack has moved to the heap, it stays there until it is reset.
+  if (thread_local_.owns_memory_ && !thread_local_.IsInReservation()) {
+    return false;
+  }
+  v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+  if (thread_local_.reservation_ == nullptr) {
+    DCHECK(!thread_local_.owns_memory_);
+    void* reservation = AllocatePages(
+        page_allocator, page_allocator->GetRandomMmapAddr(), kReservationSize,
+        page_allocator->AllocatePageSize(), PageAllocator::kNoAccess);
+    if (reservation == nullptr) return false;
+    thread_local_.reservation_ = static_cast<uint8_t*>(reservation);
+    thread_local_.committed_size_ = 0;
+  }
+
+  uint8_t* reservation_top = thread_local_.reservation_ + kReservationSize;
+  size_t commit_size = RoundUp(size, page_allocator->CommitPageSize());
+  if (commit_size > thread_local_.committed_size_) {
+    // Only the newly used pages below the committed ones change, so the
+    // stack contents stay where they are.
+    if (!SetPermissions(page_allocator, reservation_top - commit_size,
+                        commit_size - thread_local_.committed_size_,
+                        PageAllocator::kReadWrite)) {
+      return false;
+    }
+    thread_local_.committed_size_ = commit_size;
+  }
+
+  ptrdiff_t delta = sp_top_delta();
+  if (!thread_local_.owns_memory_ && thread_local_.memory_size_ > 0) {
+    // Move the static stack to the top of the reserved region.
+    MemCopy(reservation_top - thread_local_.memory_size_,
+            thread_local_.memory_, thread_local_.memory_size_);
+  }
+  // Pages retained from earlier executions may already be committed, but
+  // the stack only grows as needed so that its size is the high-water mark.
+  uint8_t* new_memory = reservation_top - commit_size;
+  thread_local_.memory_ = new_memory;
+  thread_local_.memory_top_ = reservation_top;
+  thread_local_.memory_size_ = commit_size;
+  thread_local_.stack_pointer_ = thread_local_.memory_top_ + delta;
+  thread_local_.limit_ = reinterpret_cast<Address>(new_memory) +
+                         kStackLimitSlack * kSystemPointerSize;
+  thread_local_.owns_memory_ = true;
+  return true;
+}
+
+void RegExpStack::GrowOnHeap(size_t size) {
+  uint8_t* new_memory = NewArray<uint8_t>(size);
+  if (thread_local_.memory_size_ > 0) {
+    // Copy original memory into top of new memory.
+    MemCopy(new_memory + size - thread_local_.memory_size_,
+            thread_local_.memory_, thread_local_.memory_size_);
+    if (thread_local_.owns_memory_ && !thread_local_.IsInReservation()) {
+      DeleteArray(thread_local_.memory_);
+    }
+  }
+  ptrdiff_t delta = sp_top_delta();
+  thread_local_.memory_ = new_memory;
+  thread_local_.memory_top_ = new_memory + size;
+  thread_local_.memory_size_ = size;
+  thread_local_.stack_pointer_ = thread_local_.memory_top_ + delta;
+  thread_local_.limit_ = reinterpret_cast<Address>(new_memory) +
+                         kStackLimitSlack * kSystemPointerSize;
+  thread_local_.owns_memory_ = true;
+}
 
 }  // namespace internal
 }  // namespace v8
@@ -29,6 +29,7 @@ class V8_NODISCARD RegExpStackScope final {
   RegExpStack* stack() const { return regexp_stack_; }
 
  private:
+  Isolate* const isolate_;
   RegExpStack* const regexp_stack_;
   const ptrdiff_t old_sp_top_delta_;
 };
@@ -65,7 +66,11 @@ class RegExpStack final {
   Address* limit_address_address() { return &thread_local_.limit_; }
 
   // Ensures that there is a memory area with at least the specified size.
-  // If passing zero, the default/minimum size buffer is allocated.
+  // If passing zero, the default/minimum size buffer is allocated. Dynamic
+  // stacks grow downwards within a reserved region of `kReservationSize`
+  // bytes, so the top of the stack doesn't move and nothing is copied. Larger
+  // stacks, or stacks for which the region can't be reserved, are reallocated
+  // on the heap on every growth.
   Address EnsureCapacity(size_t size);
 
   // Thread local archiving.
@@ -87,6 +92,21 @@ class RegExpStack final {
   // Minimal size of dynamically-allocated stack area.
   static constexpr size_t kMinimumDynamicStackSize = 1 * KB;
 
+  // Size of the address space reserved for dynamic stacks. Every RegExpStack
+  // and every archived thread that outgrew its static stack holds such a
+  // region, which would exhaust the address space of 32-bit hosts if it could
+  // hold the maximum stack size.
+#if V8_HOST_ARCH_64_BIT
+  static constexpr size_t kReservationSize = kMaximumStackSize;
+#else
+  static constexpr size_t kReservationSize = 1 * MB;
+#endif
+
+  // Committed memory of the reserved region up to this size is kept when the
+  // stack is reset to the static stack, for the next execution that needs a
+  // dynamic stack.
+  static constexpr size_t kRetainedStackSize = 64 * KB;
+
   // In addition to dynamically-allocated, variable-sized stacks, we also have
   // a statically allocated and sized area that is used whenever no dynamic
   // stack is allocated. This guarantees that a stack is always available and
@@ -98,6 +118,7 @@ class RegExpStack final {
   uint8_t static_stack_[kStaticStackSize] = {0};
 
   static_assert(kStaticStackSize <= kMaximumStackSize);
+  static_assert(kRetainedStackSize <= kReservationSize);
 
   // Structure holding the allocated memory, size and limit. Thread switching
   // archives and restores this struct.
@@ -115,7 +136,20 @@ class RegExpStack final {
     size_t memory_size_ = 0;
     uint8_t* stack_pointer_ = nullptr;
     Address limit_ = kNullAddress;
-    bool owns_memory_ = false;  // Whether memory_ is owned and must be freed.
+    bool owns_memory_ = false;  // Whether memory_ is a dynamic stack.
+
+    // The reserved region of kReservationSize bytes for dynamic stacks, or
+    // nullptr. Its top `committed_size_` bytes are accessible. It is kept
+    // while the static stack is used.
+    uint8_t* reservation_ = nullptr;
+    size_t committed_size_ = 0;
+
+    // Whether the dynamic stack is in the reserved region rather than on the
+    // heap, where it must be freed.
+    bool IsInReservation() const {
+      return reservation_ != nullptr &&
+             memory_top_ == reservation_ + kReservationSize;
+    }
 
     void ResetToStaticStack(RegExpStack* regexp_stack);
     void ResetToStaticStackIfEmpty(RegExpStack* regexp_stack) {
@@ -142,6 +176,13 @@ class RegExpStack final {
     return result;
   }
 
+  // Grows the dynamic stack in the reserved region, reserving it first if
+  // needed. Returns false if the stack doesn't fit into it or the region can't
+  // be reserved or committed.
+  bool GrowInReservation(size_t size);
+  // Copies the stack to a new, larger heap buffer.
+  void GrowOnHeap(size_t size);
+
   // Resets the buffer if it has grown beyond the default/minimum size and is
   // empty.
   void ResetIfEmpty() { thread_local_.ResetToStaticStackIfEmpty(this); }
@@ -149,6 +190,12 @@ class RegExpStack final {
   // Whether the ThreadLocal storage has been invalidated.
   bool IsValid() const { return thread_local_.memory_ != nullptr; }
 
+  // Whether the stack is a dynamic stack and holds no entries.
+  bool IsDynamicAndEmpty() const {
+    return thread_local_.owns_memory_ &&
+           thread_local_.stack_pointer_ == thread_local_.memory_top_;
+  }
+
   ThreadLocal thread_local_;
 
   friend class ExternalReference;
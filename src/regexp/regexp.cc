@@ -38,7 +38,8 @@ class RegExpImpl final : public AllStatic {
   // Prepares a JSRegExp object with Irregexp-specific data.
   static void IrregexpInitialize(Isolate* isolate, Handle<JSRegExp> re,
                                  Handle<String> pattern, RegExpFlags flags,
-                                 int capture_count, uint32_t backtrack_limit);
+                                 int capture_count, uint32_t backtrack_limit,
+                                 MaybeHandle<String> literal_prefix);
 
   // Prepare a RegExp for being executed one or more times (using
   // IrregexpExecOnce) on the subject.
@@ -188,6 +189,65 @@ bool HasFewDifferentCharacters(Handle<String> pattern) {
   return true;
 }
 
+// Shorter literal prefixes are left to the lookahead of the generated code.
+constexpr size_t kMinLiteralPrefixLength = 2;
+
+// Appends the one-byte characters that every match of {tree} starts with to
+// {prefix}. Returns true if the whole of {tree} is literal, i.e. if the prefix
+// may be continued with whatever follows {tree}.
+bool CollectLiteralPrefix(RegExpTree* tree, std::vector<uint8_t>* prefix) {
+  if (tree->IsAtom()) {
+    for (base::uc16 c : tree->AsAtom()->data()) {
+      if (c > String::kMaxOneByteCharCode) return false;
+      prefix->push_back(static_cast<uint8_t>(c));
+    }
+    return true;
+  } else if (tree->IsText()) {
+    for (const TextElement& element : *tree->AsText()->elements()) {
+      if (element.text_type() != TextElement::ATOM) return false;
+      if (!CollectLiteralPrefix(element.atom(), prefix)) return false;
+    }
+    return true;
+  } else if (tree->IsAlternative()) {
+    for (RegExpTree* node : *tree->AsAlternative()->nodes()) {
+      if (!CollectLiteralPrefix(node, prefix)) return false;
+    }
+    return true;
+  } else if (tree->IsCapture()) {
+    return CollectLiteralPrefix(tree->AsCapture()->body(), prefix);
+  } else if (tree->IsGroup()) {
+    RegExpGroup* group = tree->AsGroup();
+    // Modifiers may enable case-insensitive matching for the group.
+    if (IsIgnoreCase(group->flags())) return false;
+    return CollectLiteralPrefix(group->body(), prefix);
+  } else if (tree->IsQuantifier()) {
+    // The first iteration of the body is mandatory, but we don't know what
+    // follows it.
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() > 0) {
+      CollectLiteralPrefix(quantifier->body(), prefix);
+    }
+    return false;
+  } else if (tree->IsEmpty()) {
+    return true;
+  }
+  return false;
+}
+
+// Returns the literal prefix of the given regexp, or an empty handle if it
+// doesn't have one that is worth searching for. Sticky regexps must match at
+// the last index, and case-insensitive regexps don't match a fixed string.
+MaybeHandle<String> LiteralPrefix(Isolate* isolate, RegExpTree* tree,
+                                  RegExpFlags flags) {
+  if (!v8_flags.regexp_literal_prefix_search) return {};
+  if (IsIgnoreCase(flags) || IsSticky(flags)) return {};
+  std::vector<uint8_t> prefix;
+  CollectLiteralPrefix(tree, &prefix);
+  if (prefix.size() < kMinLiteralPrefixLength) return {};
+  return isolate->factory()->NewStringFromOneByte(base::VectorOf(prefix),
+                                                  AllocationType::kOld);
+}
+
 }  // namespace
 
 // Generic RegExp methods. Dispatches to implementation specific methods.
@@ -269,8 +329,9 @@ MaybeHandle<Object> RegExp::Compile(Isolate* isolate, Handle<JSRegExp> re,
     }
   }
   if (!has_been_compiled) {
-    RegExpImpl::IrregexpInitialize(isolate, re, pattern, flags,
-                                   parse_result.capture_count, backtrack_limit);
+    RegExpImpl::IrregexpInitialize(
+        isolate, re, pattern, flags, parse_result.capture_count,
+        backtrack_limit, LiteralPrefix(isolate, parse_result.tree, flags));
   }
   DCHECK(IsFixedArray(re->data()));
   // Compilation succeeded so the data is set on the regexp
@@ -650,11 +711,16 @@ Tagged<Code> RegExpImpl::IrregexpNativeCode(IsolateForSandbox isolate,
 void RegExpImpl::IrregexpInitialize(Isolate* isolate, Handle<JSRegExp> re,
                                     Handle<String> pattern, RegExpFlags flags,
                                     int capture_count,
-                                    uint32_t backtrack_limit) {
+                                    uint32_t backtrack_limit,
+                                    MaybeHandle<String> literal_prefix) {
   // Initialize compiled code entries to null.
   isolate->factory()->SetRegExpIrregexpData(re, pattern,
                                             JSRegExp::AsJSRegExpFlags(flags),
                                             capture_count, backtrack_limit);
+  Handle<String> prefix;
+  if (literal_prefix.ToHandle(&prefix)) {
+    re->SetDataAt(JSRegExp::kIrregexpLiteralPrefixIndex, *prefix);
+  }
 }
 
 // static
@@ -683,6 +749,24 @@ int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
   DCHECK_GE(output_size,
             JSRegExp::RegistersForCaptureCount(regexp->capture_count()));
 
+  // Every match starts with the literal prefix, so skip ahead to its first
+  // occurrence. If there is none, there is no match either.
+  Tagged<Object> literal_prefix =
+      regexp->DataAt(JSRegExp::kIrregexpLiteralPrefixIndex);
+  if (IsString(literal_prefix)) {
+    DisallowGarbageCollection no_gc;
+    String::FlatContent prefix_content =
+        String::cast(literal_prefix)->GetFlatContent(no_gc);
+    String::FlatContent subject_content = subject->GetFlatContent(no_gc);
+    DCHECK(prefix_content.IsOneByte());
+    index = subject_content.IsOneByte()
+                ? SearchString(isolate, subject_content.ToOneByteVector(),
+                               prefix_content.ToOneByteVector(), index)
+                : SearchString(isolate, subject_content.ToUC16Vector(),
+                               prefix_content.ToOneByteVector(), index);
+    if (index == -1) return RegExp::RE_FAILURE;
+  }
+
   bool is_one_byte = String::IsOneByteRepresentationUnderneath(*subject);
 
   if (!regexp->ShouldProduceBytecode()) {
@@ -665,6 +665,40 @@ RUNTIME_FUNCTION(Runtime_WasmCompiledExportWrappersCount) {
   return Smi::FromInt(count);
 }
 
+namespace {
+Tagged<Smi> StatsCounterValue(StatsCounter* counter) {
+  // Without a counter lookup function, all counters share a single dummy
+  // location, whose value would be meaningless here.
+  CHECK_WITH_MSG(counter->Enabled(),
+                 "Reading stats counters requires --dump-counters");
+  return Smi::FromInt(counter->Get());
+}
+}  // namespace
+
+RUNTIME_FUNCTION(Runtime_WasmExportWrapperCacheHits) {
+  return StatsCounterValue(
+      isolate->counters()->wasm_export_wrapper_cache_hits());
+}
+
+RUNTIME_FUNCTION(Runtime_WasmExportWrapperCacheMisses) {
+  return StatsCounterValue(
+      isolate->counters()->wasm_export_wrapper_cache_misses());
+}
+
+RUNTIME_FUNCTION(Runtime_WasmImportWrapperCacheHits) {
+  return StatsCounterValue(
+      isolate->counters()->wasm_import_wrapper_cache_hits());
+}
+
+RUNTIME_FUNCTION(Runtime_WasmImportWrapperCacheMisses) {
+  return StatsCounterValue(
+      isolate->counters()->wasm_import_wrapper_cache_misses());
+}
+
+RUNTIME_FUNCTION(Runtime_WasmStackPoolHits) {
+  return StatsCounterValue(isolate->counters()->wasm_stack_pool_hits());
+}
+
 RUNTIME_FUNCTION(Runtime_WasmSwitchToTheCentralStackCount) {
   int count = isolate->wasm_switch_to_the_central_stack_counter();
   return Smi::FromInt(count);
@@ -625,7 +625,10 @@ RUNTIME_FUNCTION(Runtime_TierUpWasmToJSWrapper) {
   wasm::WasmImportWrapperCache* cache = native_module->import_wrapper_cache();
   wasm::WasmCode* wasm_code =
       cache->MaybeGet(kind, canonical_sig_index, expected_arity, suspend);
-  if (!wasm_code) {
+  if (wasm_code) {
+    isolate->counters()->wasm_import_wrapper_cache_hits()->Increment();
+  } else {
+    isolate->counters()->wasm_import_wrapper_cache_misses()->Increment();
     wasm::WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
         &env, kind, &sig, false, expected_arity, suspend);
     std::unique_ptr<wasm::WasmCode> compiled_code = native_module->AddCode(
@@ -713,10 +713,15 @@ namespace internal {
   F(SetWasmInstantiateControls, 0, 1)                      \
   F(WasmCompiledExportWrappersCount, 0, 1)                 \
   F(WasmEnterDebugging, 0, 1)                              \
+  F(WasmExportWrapperCacheHits, 0, 1)                      \
+  F(WasmExportWrapperCacheMisses, 0, 1)                    \
   IF_NO_OFFICIAL_BUILD(F, WasmGenerateRandomModule, -1, 1) \
   F(WasmGetNumberOfInstances, 1, 1)                        \
+  F(WasmImportWrapperCacheHits, 0, 1)                      \
+  F(WasmImportWrapperCacheMisses, 0, 1)                    \
   F(WasmLeaveDebugging, 0, 1)                              \
   F(WasmNumCodeSpaces, 1, 1)                               \
+  F(WasmStackPoolHits, 0, 1)                               \
   F(WasmSwitchToTheCentralStackCount, 0, 1)                \
   F(WasmTierUpFunction, 1, 1)                              \
   F(WasmTraceEnter, 0, 1)                                  \
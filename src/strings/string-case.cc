@@ -7,6 +7,7 @@
 #include "src/base/logging.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
+#include "src/strings/string-simd.h"
 #include "src/utils/utils.h"
 
 namespace v8 {
@@ -66,6 +67,14 @@ int FastAsciiConvert(char* dst, const char* src, int length,
 #endif
   const char* saved_src = src;
   DisallowGarbageCollection no_gc;
+  if (StringSimd::IsEnabledFor(length)) {
+    int converted = static_cast<int>(
+        StringSimd::AsciiConvert<is_lower>(dst, src, length, changed_out));
+    DCHECK_IMPLIES(converted == length,
+                   CheckFastAsciiConvert(saved_dst, saved_src, length,
+                                         *changed_out, is_lower));
+    return converted;
+  }
   // We rely on the distance between upper and lower case letters
   // being a known power of 2.
   DCHECK_EQ('a' - 'A', 1 << 5);
@@ -0,0 +1,543 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-simd.h"
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/codegen/cpu-features.h"
+
+#ifdef _MSC_VER
+// MSVC doesn't define SSE3. However, it does define AVX, and AVX implies SSE3.
+#ifdef __AVX__
+#ifndef __SSE3__
+#define __SSE3__
+#endif
+#endif
+#endif
+
+#ifdef __SSE3__
+#include <immintrin.h>
+#endif
+
+#ifdef V8_HOST_ARCH_ARM64
+// We use Neon only on 64-bit ARM (because on 32-bit, some instructions and some
+// types are not available). Note that ARM64 is guaranteed to have Neon.
+#define NEON64
+#include <arm_neon.h>
+#endif
+
+// Since we don't compile with -mavx2 (or /arch:AVX2 on MSVC), the AVX2 kernels
+// are compiled for that target explicitly and only called if the CPU supports
+// AVX2. Generating AVX2 code with Clang on Windows without the /arch:AVX2 flag
+// does not seem possible at the moment.
+#if defined(__SSE3__) && !defined(_M_IX86) &&       \
+    !(defined(_MSC_VER) && defined(__clang__)) &&   \
+    (defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64))
+#define STRING_SIMD_AVX2
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace v8 {
+namespace internal {
+
+StringSimd::Kind StringSimd::kind_ = StringSimd::Kind::kNone;
+
+namespace {
+
+// The scalar loops process the characters that don't fill a vector register,
+// starting at |index|.
+
+size_t NonAsciiStartScalar(const uint8_t* chars, size_t index, size_t length) {
+  for (; index < length; ++index) {
+    if (chars[index] > 0x7F) return index;
+  }
+  return length;
+}
+
+size_t NonOneByteStartScalar(const uint16_t* chars, size_t index,
+                             size_t length) {
+  for (; index < length; ++index) {
+    if (chars[index] > 0xFF) return index;
+  }
+  return length;
+}
+
+bool EqualsScalar(const uint8_t* lhs, const uint16_t* rhs, size_t index,
+                  size_t length) {
+  for (; index < length; ++index) {
+    if (lhs[index] != rhs[index]) return false;
+  }
+  return true;
+}
+
+size_t NarrowAsciiScalar(uint8_t* dst, const uint16_t* src, size_t index,
+                         size_t length) {
+  for (; index < length; ++index) {
+    if (src[index] > 0x7F) return index;
+    dst[index] = static_cast<uint8_t>(src[index]);
+  }
+  return length;
+}
+
+template <bool is_lower>
+size_t AsciiConvertScalar(char* dst, const char* src, size_t index,
+                          size_t length, bool* changed) {
+  constexpr char lo = is_lower ? 'A' : 'a';
+  constexpr char hi = is_lower ? 'Z' : 'z';
+  for (; index < length; ++index) {
+    char c = src[index];
+    if (static_cast<uint8_t>(c) > 0x7F) return index;
+    if (lo <= c && c <= hi) {
+      c ^= 0x20;
+      *changed = true;
+    }
+    dst[index] = c;
+  }
+  return length;
+}
+
+#ifdef __SSE3__
+
+size_t NonAsciiStartSSE(const uint8_t* chars, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    uint32_t non_ascii = _mm_movemask_epi8(v);
+    if (non_ascii != 0) {
+      return i + base::bits::CountTrailingZeros32(non_ascii);
+    }
+  }
+  return NonAsciiStartScalar(chars, i, length);
+}
+
+size_t NonOneByteStartSSE(const uint16_t* chars, size_t length) {
+  constexpr size_t kChars = sizeof(__m128i) / sizeof(uint16_t);
+  const __m128i high_bytes = _mm_set1_epi16(static_cast<int16_t>(0xFF00));
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    __m128i one_byte = _mm_cmpeq_epi16(_mm_and_si128(v, high_bytes), zero);
+    // Two mask bits per character.
+    uint32_t non_one_byte = _mm_movemask_epi8(one_byte) ^ 0xFFFF;
+    if (non_one_byte != 0) {
+      return i + base::bits::CountTrailingZeros32(non_one_byte) / 2;
+    }
+  }
+  return NonOneByteStartScalar(chars, i, length);
+}
+
+bool EqualsSSE(const uint8_t* lhs, const uint16_t* rhs, size_t length) {
+  constexpr size_t kChars = sizeof(__m128i);
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    __m128i r_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    __m128i r_hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i + 8));
+    __m128i eq = _mm_and_si128(
+        _mm_cmpeq_epi16(_mm_unpacklo_epi8(l, zero), r_lo),
+        _mm_cmpeq_epi16(_mm_unpackhi_epi8(l, zero), r_hi));
+    if (_mm_movemask_epi8(eq) != 0xFFFF) return false;
+  }
+  return EqualsScalar(lhs, rhs, i, length);
+}
+
+size_t NarrowAsciiSSE(uint8_t* dst, const uint16_t* src, size_t length) {
+  constexpr size_t kChars = sizeof(__m128i);
+  const __m128i non_ascii_bits = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    __m128i non_ascii =
+        _mm_and_si128(_mm_or_si128(lo, hi), non_ascii_bits);
+    // Leave the non-ASCII character to the scalar loop, which finds it.
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, zero)) != 0xFFFF) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+  return NarrowAsciiScalar(dst, src, i, length);
+}
+
+template <bool is_lower>
+size_t AsciiConvertSSE(char* dst, const char* src, size_t length,
+                       bool* changed_out) {
+  // Only ASCII characters are converted, so signed comparisons work.
+  const __m128i lo = _mm_set1_epi8(is_lower ? 'A' - 1 : 'a' - 1);
+  const __m128i hi = _mm_set1_epi8(is_lower ? 'Z' + 1 : 'z' + 1);
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  __m128i changed = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + sizeof(__m128i) <= length; i += sizeof(__m128i)) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // Leave the non-ASCII character to the scalar loop, which finds it.
+    if (_mm_movemask_epi8(v) != 0) break;
+    __m128i letters =
+        _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi));
+    changed = _mm_or_si128(changed, letters);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_xor_si128(v, _mm_and_si128(letters, case_bit)));
+  }
+  bool any_changed = _mm_movemask_epi8(changed) != 0;
+  size_t end =
+      AsciiConvertScalar<is_lower>(dst, src, i, length, &any_changed);
+  if (end == length) *changed_out = any_changed;
+  return end;
+}
+
+#endif  // __SSE3__
+
+#ifdef STRING_SIMD_AVX2
+
+TARGET_AVX2 size_t NonAsciiStartAVX2(const uint8_t* chars, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i)) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + i));
+    uint32_t non_ascii = _mm256_movemask_epi8(v);
+    if (non_ascii != 0) {
+      return i + base::bits::CountTrailingZeros32(non_ascii);
+    }
+  }
+  return NonAsciiStartScalar(chars, i, length);
+}
+
+TARGET_AVX2 size_t NonOneByteStartAVX2(const uint16_t* chars, size_t length) {
+  constexpr size_t kChars = sizeof(__m256i) / sizeof(uint16_t);
+  const __m256i high_bytes = _mm256_set1_epi16(static_cast<int16_t>(0xFF00));
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + i));
+    __m256i one_byte =
+        _mm256_cmpeq_epi16(_mm256_and_si256(v, high_bytes), zero);
+    // Two mask bits per character.
+    uint32_t non_one_byte = ~static_cast<uint32_t>(
+        _mm256_movemask_epi8(one_byte));
+    if (non_one_byte != 0) {
+      return i + base::bits::CountTrailingZeros32(non_one_byte) / 2;
+    }
+  }
+  return NonOneByteStartScalar(chars, i, length);
+}
+
+TARGET_AVX2 bool EqualsAVX2(const uint8_t* lhs, const uint16_t* rhs,
+                            size_t length) {
+  constexpr size_t kChars = sizeof(__m256i) / sizeof(uint16_t);
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m256i l = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)));
+    __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    if (static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi16(l, r))) != 0xFFFFFFFF) {
+      return false;
+    }
+  }
+  return EqualsScalar(lhs, rhs, i, length);
+}
+
+TARGET_AVX2 size_t NarrowAsciiAVX2(uint8_t* dst, const uint16_t* src,
+                                   size_t length) {
+  constexpr size_t kChars = sizeof(__m256i);
+  const __m256i non_ascii_bits =
+      _mm256_set1_epi16(static_cast<int16_t>(0xFF80));
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i hi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+    __m256i non_ascii =
+        _mm256_and_si256(_mm256_or_si256(lo, hi), non_ascii_bits);
+    // Leave the non-ASCII character to the scalar loop, which finds it.
+    if (!_mm256_testz_si256(non_ascii, non_ascii)) break;
+    // The packing interleaves the 128-bit lanes of both inputs.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi),
+                                              0b11011000);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+  }
+  return NarrowAsciiScalar(dst, src, i, length);
+}
+
+template <bool is_lower>
+TARGET_AVX2 size_t AsciiConvertAVX2(char* dst, const char* src, size_t length,
+                                    bool* changed_out) {
+  // Only ASCII characters are converted, so signed comparisons work.
+  const __m256i lo = _mm256_set1_epi8(is_lower ? 'A' - 1 : 'a' - 1);
+  const __m256i hi = _mm256_set1_epi8(is_lower ? 'Z' + 1 : 'z' + 1);
+  const __m256i case_bit = _mm256_set1_epi8(0x20);
+  __m256i changed = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + sizeof(__m256i) <= length; i += sizeof(__m256i)) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    // Leave the non-ASCII character to the scalar loop, which finds it.
+    if (_mm256_movemask_epi8(v) != 0) break;
+    __m256i letters =
+        _mm256_and_si256(_mm256_cmpgt_epi8(v, lo), _mm256_cmpgt_epi8(hi, v));
+    changed = _mm256_or_si256(changed, letters);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i),
+        _mm256_xor_si256(v, _mm256_and_si256(letters, case_bit)));
+  }
+  bool any_changed = _mm256_movemask_epi8(changed) != 0;
+  size_t end =
+      AsciiConvertScalar<is_lower>(dst, src, i, length, &any_changed);
+  if (end == length) *changed_out = any_changed;
+  return end;
+}
+
+#endif  // STRING_SIMD_AVX2
+
+#ifdef NEON64
+
+// The Neon kernels only find the vector that contains the character they look
+// for and leave its exact position to the scalar loops.
+
+size_t NonAsciiStartNeon(const uint8_t* chars, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint8x16_t) <= length; i += sizeof(uint8x16_t)) {
+    if (vmaxvq_u8(vld1q_u8(chars + i)) > 0x7F) break;
+  }
+  return NonAsciiStartScalar(chars, i, length);
+}
+
+size_t NonOneByteStartNeon(const uint16_t* chars, size_t length) {
+  constexpr size_t kChars = sizeof(uint16x8_t) / sizeof(uint16_t);
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    if (vmaxvq_u16(vld1q_u16(chars + i)) > 0xFF) break;
+  }
+  return NonOneByteStartScalar(chars, i, length);
+}
+
+bool EqualsNeon(const uint8_t* lhs, const uint16_t* rhs, size_t length) {
+  constexpr size_t kChars = sizeof(uint8x16_t);
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    uint8x16_t l = vld1q_u8(lhs + i);
+    uint16x8_t eq =
+        vandq_u16(vceqq_u16(vmovl_u8(vget_low_u8(l)), vld1q_u16(rhs + i)),
+                  vceqq_u16(vmovl_high_u8(l), vld1q_u16(rhs + i + 8)));
+    if (vminvq_u16(eq) == 0) return false;
+  }
+  return EqualsScalar(lhs, rhs, i, length);
+}
+
+size_t NarrowAsciiNeon(uint8_t* dst, const uint16_t* src, size_t length) {
+  constexpr size_t kChars = sizeof(uint8x16_t);
+  size_t i = 0;
+  for (; i + kChars <= length; i += kChars) {
+    uint16x8_t lo = vld1q_u16(src + i);
+    uint16x8_t hi = vld1q_u16(src + i + 8);
+    if (vmaxvq_u16(vorrq_u16(lo, hi)) > 0x7F) break;
+    vst1q_u8(dst + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+  }
+  return NarrowAsciiScalar(dst, src, i, length);
+}
+
+template <bool is_lower>
+size_t AsciiConvertNeon(char* dst, const char* src, size_t length,
+                        bool* changed_out) {
+  const uint8x16_t lo = vdupq_n_u8(is_lower ? 'A' : 'a');
+  const uint8x16_t hi = vdupq_n_u8(is_lower ? 'Z' : 'z');
+  const uint8x16_t case_bit = vdupq_n_u8(0x20);
+  uint8x16_t changed = vdupq_n_u8(0);
+  size_t i = 0;
+  for (; i + sizeof(uint8x16_t) <= length; i += sizeof(uint8x16_t)) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    if (vmaxvq_u8(v) > 0x7F) break;
+    uint8x16_t letters = vandq_u8(vcgeq_u8(v, lo), vcleq_u8(v, hi));
+    changed = vorrq_u8(changed, letters);
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + i),
+             veorq_u8(v, vandq_u8(letters, case_bit)));
+  }
+  bool any_changed = vmaxvq_u8(changed) != 0;
+  size_t end =
+      AsciiConvertScalar<is_lower>(dst, src, i, length, &any_changed);
+  if (end == length) *changed_out = any_changed;
+  return end;
+}
+
+#endif  // NEON64
+
+}  // namespace
+
+// static
+void StringSimd::InitializeOncePerProcess() {
+  for (Kind kind : {Kind::kAVX2, Kind::kSSE, Kind::kNeon}) {
+    if (IsSupported(kind)) {
+      kind_ = kind;
+      return;
+    }
+  }
+}
+
+// static
+bool StringSimd::IsSupported(Kind kind) {
+  switch (kind) {
+    case Kind::kNone:
+      return true;
+    case Kind::kSSE:
+#ifdef __SSE3__
+      // No need for a runtime check since we do not support x86/x64 CPUs
+      // without SSE3.
+      return true;
+#else
+      return false;
+#endif
+    case Kind::kAVX2:
+#ifdef STRING_SIMD_AVX2
+      return CpuFeatures::IsSupported(AVX2);
+#else
+      return false;
+#endif
+    case Kind::kNeon:
+#ifdef NEON64
+      return true;
+#else
+      return false;
+#endif
+  }
+  UNREACHABLE();
+}
+
+// static
+void StringSimd::SetKindForTesting(Kind kind) {
+  CHECK(IsSupported(kind));
+  kind_ = kind;
+}
+
+// static
+size_t StringSimd::NonAsciiStart(const uint8_t* chars, size_t length) {
+  switch (kind_) {
+#ifdef __SSE3__
+    case Kind::kSSE:
+      return NonAsciiStartSSE(chars, length);
+#endif
+#ifdef STRING_SIMD_AVX2
+    case Kind::kAVX2:
+      return NonAsciiStartAVX2(chars, length);
+#endif
+#ifdef NEON64
+    case Kind::kNeon:
+      return NonAsciiStartNeon(chars, length);
+#endif
+    default:
+      return NonAsciiStartScalar(chars, 0, length);
+  }
+}
+
+// static
+size_t StringSimd::NonOneByteStart(const uint16_t* chars, size_t length) {
+  switch (kind_) {
+#ifdef __SSE3__
+    case Kind::kSSE:
+      return NonOneByteStartSSE(chars, length);
+#endif
+#ifdef STRING_SIMD_AVX2
+    case Kind::kAVX2:
+      return NonOneByteStartAVX2(chars, length);
+#endif
+#ifdef NEON64
+    case Kind::kNeon:
+      return NonOneByteStartNeon(chars, length);
+#endif
+    default:
+      return NonOneByteStartScalar(chars, 0, length);
+  }
+}
+
+// static
+bool StringSimd::Equals(const uint8_t* lhs, const uint16_t* rhs,
+                        size_t length) {
+  switch (kind_) {
+#ifdef __SSE3__
+    case Kind::kSSE:
+      return EqualsSSE(lhs, rhs, length);
+#endif
+#ifdef STRING_SIMD_AVX2
+    case Kind::kAVX2:
+      return EqualsAVX2(lhs, rhs, length);
+#endif
+#ifdef NEON64
+    case Kind::kNeon:
+      return EqualsNeon(lhs, rhs, length);
+#endif
+    default:
+      return EqualsScalar(lhs, rhs, 0, length);
+  }
+}
+
+// static
+size_t StringSimd::NarrowAscii(uint8_t* dst, const uint16_t* src,
+                               size_t length) {
+  switch (kind_) {
+#ifdef __SSE3__
+    case Kind::kSSE:
+      return NarrowAsciiSSE(dst, src, length);
+#endif
+#ifdef STRING_SIMD_AVX2
+    case Kind::kAVX2:
+      return NarrowAsciiAVX2(dst, src, length);
+#endif
+#ifdef NEON64
+    case Kind::kNeon:
+      return NarrowAsciiNeon(dst, src, length);
+#endif
+    default:
+      return NarrowAsciiScalar(dst, src, 0, length);
+  }
+}
+
+// static
+template <bool is_lower>
+size_t StringSimd::AsciiConvert(char* dst, const char* src, size_t length,
+                                bool* changed_out) {
+  switch (kind_) {
+#ifdef __SSE3__
+    case Kind::kSSE:
+      return AsciiConvertSSE<is_lower>(dst, src, length, changed_out);
+#endif
+#ifdef STRING_SIMD_AVX2
+    case Kind::kAVX2:
+      return AsciiConvertAVX2<is_lower>(dst, src, length, changed_out);
+#endif
+#ifdef NEON64
+    case Kind::kNeon:
+      return AsciiConvertNeon<is_lower>(dst, src, length, changed_out);
+#endif
+    default: {
+      bool changed = false;
+      size_t end =
+          AsciiConvertScalar<is_lower>(dst, src, 0, length, &changed);
+      if (end == length) *changed_out = changed;
+      return end;
+    }
+  }
+}
+
+template size_t StringSimd::AsciiConvert<false>(char* dst, const char* src,
+                                                size_t length,
+                                                bool* changed_out);
+template size_t StringSimd::AsciiConvert<true>(char* dst, const char* src,
+                                               size_t length,
+                                               bool* changed_out);
+
+#undef STRING_SIMD_AVX2
+#undef TARGET_AVX2
+#ifdef NEON64
+#undef NEON64
+#endif
+
+}  // namespace internal
+}  // namespace v8
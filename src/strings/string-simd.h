@@ -0,0 +1,87 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_STRINGS_STRING_SIMD_H_
+#define V8_STRINGS_STRING_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "src/common/globals.h"
+#include "src/utils/utils.h"
+
+namespace v8 {
+namespace internal {
+
+// Vectorized versions of the loops that scan, compare and case-convert the
+// characters of long strings. The instruction set is selected once per process
+// from the features of the CPU. The callers only use these kernels for at
+// least kMinLength characters, below which their word-at-a-time loops are just
+// as fast.
+class V8_EXPORT_PRIVATE StringSimd final : public AllStatic {
+ public:
+  enum class Kind : uint8_t { kNone, kSSE, kAVX2, kNeon };
+
+  static constexpr size_t kMinLength = 32;
+
+  // Must be called after CpuFeatures::Probe().
+  static void InitializeOncePerProcess();
+
+  static bool IsEnabledFor(size_t length) {
+    return length >= kMinLength && kind_ != Kind::kNone;
+  }
+
+  static Kind kind() { return kind_; }
+  static bool IsSupported(Kind kind);
+  // Switches to another supported kind, e.g. to compare the kernels with each
+  // other and, with kNone, with the scalar loops of their callers.
+  static void SetKindForTesting(Kind kind);
+
+  // Returns the index of the first character above 0x7F, or |length| if there
+  // is none.
+  static size_t NonAsciiStart(const uint8_t* chars, size_t length);
+  // Returns the index of the first character above 0xFF, or |length| if there
+  // is none.
+  static size_t NonOneByteStart(const uint16_t* chars, size_t length);
+  static bool Equals(const uint8_t* lhs, const uint16_t* rhs, size_t length);
+
+  // Copies the ASCII characters at the start of |src| to |dst|, narrowing them
+  // to one byte, and returns their number.
+  static size_t NarrowAscii(uint8_t* dst, const uint16_t* src, size_t length);
+
+  // Converts ASCII letters to lower (or upper) case, like FastAsciiConvert.
+  // Stops at the first non-ASCII character and returns its index, or |length|
+  // if there is none, in which case |changed_out| tells whether any letter was
+  // converted.
+  template <bool is_lower>
+  static size_t AsciiConvert(char* dst, const char* src, size_t length,
+                             bool* changed_out);
+
+ private:
+  static Kind kind_;
+};
+
+// Like CompareCharsEqual(), but compares long runs of one-byte with two-byte
+// characters with StringSimd::Equals().
+template <typename lchar, typename rchar>
+inline bool CompareCharsEqualWithSimd(const lchar* lhs, const rchar* rhs,
+                                      size_t chars) {
+  if constexpr (sizeof(lchar) == 1 && sizeof(rchar) == 2) {
+    if (StringSimd::IsEnabledFor(chars)) {
+      return StringSimd::Equals(reinterpret_cast<const uint8_t*>(lhs),
+                                reinterpret_cast<const uint16_t*>(rhs), chars);
+    }
+  } else if constexpr (sizeof(lchar) == 2 && sizeof(rchar) == 1) {
+    if (StringSimd::IsEnabledFor(chars)) {
+      return StringSimd::Equals(reinterpret_cast<const uint8_t*>(rhs),
+                                reinterpret_cast<const uint16_t*>(lhs), chars);
+    }
+  }
+  return CompareCharsEqual(lhs, rhs, chars);
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_STRINGS_STRING_SIMD_H_
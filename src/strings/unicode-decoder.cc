@@ -4,6 +4,8 @@
 
 #include "src/strings/unicode-decoder.h"
 
+#include <algorithm>
+
 #include "src/strings/unicode-inl.h"
 #include "src/utils/memcopy.h"
 
@@ -54,6 +56,18 @@ struct DecoderTraits<StrictUtf8Decoder> {
   using DfaDecoder = Utf8DfaDecoder;
 };
 #endif  // V8_ENABLE_WEBASSEMBLY
+
+// Returns the length of the run of ASCII characters that starts at |cursor|,
+// or a lower bound of it. Text in most languages mixes ASCII characters, like
+// spaces and punctuation, with non-ASCII ones, so runs are only scanned for in
+// bulk if they don't end right away.
+int AsciiRunLength(const uint8_t* cursor, const uint8_t* end) {
+  DCHECK_LE(*cursor, unibrow::Utf8::kMaxOneByteChar);
+  int length = static_cast<int>(end - cursor);
+  if (length == 1 || cursor[1] > unibrow::Utf8::kMaxOneByteChar) return 1;
+  return std::max(NonAsciiStart(cursor, length), 2);
+}
+
 }  // namespace
 
 template <class Decoder>
@@ -76,9 +90,10 @@ Utf8DecoderBase<Decoder>::Utf8DecoderBase(base::Vector<const uint8_t> data)
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
       DCHECK(!Traits::IsInvalidSurrogatePair(previous, *cursor));
-      previous = *cursor;
-      utf16_length_++;
-      cursor++;
+      int ascii_length = AsciiRunLength(cursor, end);
+      cursor += ascii_length;
+      previous = cursor[-1];
+      utf16_length_ += ascii_length;
       continue;
     }
 
@@ -144,8 +159,10 @@ void Utf8DecoderBase<Decoder>::Decode(Char* out,
     if (V8_LIKELY(*cursor <= unibrow::Utf8::kMaxOneByteChar &&
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
-      *(out++) = static_cast<Char>(*cursor);
-      cursor++;
+      int ascii_length = AsciiRunLength(cursor, end);
+      CopyChars(out, cursor, ascii_length);
+      out += ascii_length;
+      cursor += ascii_length;
       continue;
     }
 
@@ -6,6 +6,7 @@
 #define V8_STRINGS_UNICODE_DECODER_H_
 
 #include "src/base/vector.h"
+#include "src/strings/string-simd.h"
 #include "src/strings/unicode.h"
 
 namespace v8 {
@@ -16,6 +17,11 @@ namespace internal {
 // If the return value is >= the passed length, the entire string was
 // one-byte.
 inline int NonAsciiStart(const uint8_t* chars, int length) {
+  // Don't call out if the answer is 0, which is common for non-Latin text.
+  if (StringSimd::IsEnabledFor(length) &&
+      chars[0] <= unibrow::Utf8::kMaxOneByteChar) {
+    return static_cast<int>(StringSimd::NonAsciiStart(chars, length));
+  }
   const uint8_t* start = chars;
   const uint8_t* limit = chars + length;
 
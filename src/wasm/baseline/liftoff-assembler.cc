@@ -472,6 +472,33 @@ void LiftoffAssembler::PrepareLoopArgs(int num) {
   }
 }
 
+void LiftoffAssembler::PrepareLoopLocal(uint32_t local_index) {
+  DCHECK_LT(local_index, num_locals());
+  VarState& slot = cache_state_.stack_state[local_index];
+  if (slot.is_reg() && cache_state_.get_use_count(slot.reg()) == 1) return;
+  RegClass rc = reg_class_for(slot.kind());
+  if (!cache_state_.has_unused_register(rc)) {
+    Spill(&slot);
+    return;
+  }
+  LiftoffRegister reg = cache_state_.unused_register(rc);
+  switch (slot.loc()) {
+    case VarState::kStack:
+      Fill(reg, slot.offset(), slot.kind());
+      break;
+    case VarState::kRegister:
+      // Registers used more than once can't be used for merges.
+      Move(reg, slot.reg(), slot.kind());
+      cache_state_.dec_used(slot.reg());
+      break;
+    case VarState::kIntConst:
+      LoadConstant(reg, slot.constant());
+      break;
+  }
+  cache_state_.inc_used(reg);
+  slot.MakeRegister(reg);
+}
+
 void LiftoffAssembler::PrepareForBranch(uint32_t arity, LiftoffRegList pinned) {
   VarState* stack_base = cache_state_.stack_state.data();
   for (auto slots :
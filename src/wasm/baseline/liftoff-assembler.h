@@ -464,6 +464,12 @@ class LiftoffAssembler : public MacroAssembler {
   // stack, so that we can merge different values on the back-edge.
   void PrepareLoopArgs(int num);
 
+  // Keep the local at {local_index} in a register across the loop that is about
+  // to be entered: The local is moved or loaded into a register that is not
+  // shared with any other stack slot, so that the back-edges can merge into it.
+  // If no register is free, the local is spilled instead.
+  void PrepareLoopLocal(uint32_t local_index);
+
   V8_INLINE static int NextSpillOffset(ValueKind kind, int top_spill_offset);
   V8_INLINE int NextSpillOffset(ValueKind kind);
   inline int TopSpillOffset() const;
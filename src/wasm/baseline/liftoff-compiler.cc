@@ -613,6 +613,7 @@ class LiftoffCompiler {
         next_breakpoint_end_(options.breakpoints.end()),
         dead_breakpoint_(options.dead_breakpoint),
         handlers_(zone),
+        loop_local_uses_(zone),
         max_steps_(options.max_steps),
         nondeterminism_(options.nondeterminism) {
     // We often see huge numbers of traps per function, so pre-reserve some
@@ -1383,13 +1384,156 @@ class LiftoffCompiler {
 
   void Block(FullDecoder* decoder, Control* block) { PushControl(block); }
 
+  // The locals used in a loop, and the cached values it needs. Computed by
+  // {AnalyzeLoop}.
+  struct LoopAnalysis {
+    // The accessed locals, in the order of their first access. Their weighted
+    // number of accesses is stored in {loop_local_uses_}.
+    base::SmallVector<uint32_t, 8> locals;
+    bool uses_instance = false;
+    bool uses_memory = false;
+  };
+
+  // Loops with a larger body are not analyzed, to keep compile time linear in
+  // the common case (nested loops are analyzed once per enclosing loop).
+  static constexpr uint32_t kMaxAnalyzedLoopSize = 4 * KB;
+
+  // Quick pre-pass over the loop starting at {pc}, which counts the accesses to
+  // locals and finds out whether the instance and the memory start are used.
+  // Accesses in nested loops are weighted higher. Returns false if keeping
+  // values in registers across the back-edges does not pay off, i.e. if the
+  // loop contains calls (which spill all registers), or if it is too large.
+  bool AnalyzeLoop(FullDecoder* decoder, const uint8_t* pc,
+                   LoopAnalysis* analysis) {
+    DCHECK_EQ(kExprLoop, *pc);
+    const uint8_t* end = decoder->end();
+    if (static_cast<size_t>(end - pc) > kMaxAnalyzedLoopSize) {
+      end = pc + kMaxAnalyzedLoopSize;
+    }
+    // For each open block, whether it's a loop.
+    base::SmallVector<bool, 16> open_blocks;
+    uint32_t loop_depth = 0;
+    do {
+      if (pc >= end) return false;
+      WasmOpcode opcode = static_cast<WasmOpcode>(*pc);
+      switch (opcode) {
+        case kExprLoop:
+          ++loop_depth;
+          open_blocks.push_back(true);
+          break;
+        case kExprIf:
+        case kExprBlock:
+        case kExprTry:
+        case kExprTryTable:
+          open_blocks.push_back(false);
+          break;
+        case kExprEnd:
+        case kExprDelegate:
+          if (open_blocks.back()) --loop_depth;
+          open_blocks.pop_back();
+          break;
+        case kExprLocalGet:
+        case kExprLocalSet:
+        case kExprLocalTee: {
+          IndexImmediate imm(decoder, pc + 1, "local index", ValidationTag{});
+          uint32_t& uses = loop_local_uses_[imm.index];
+          if (uses == 0) analysis->locals.push_back(imm.index);
+          uses += 1 << (2 * std::min(loop_depth - 1, 4u));
+          break;
+        }
+        case kExprGlobalGet:
+        case kExprGlobalSet:
+        case kExprTableGet:
+        case kExprTableSet:
+          analysis->uses_instance = true;
+          break;
+        case kExprCallFunction:
+        case kExprCallIndirect:
+        case kExprCallRef:
+        case kExprMemoryGrow:
+          return false;
+        default:
+          if (opcode >= kExprI32LoadMem && opcode <= kExprMemorySize) {
+            analysis->uses_instance = true;
+            analysis->uses_memory = true;
+          }
+          break;
+      }
+      pc += FullDecoder::OpcodeLength(decoder, pc);
+    } while (!open_blocks.empty());
+    return true;
+  }
+
+  // Instead of spilling all locals before a loop, keep the locals which are
+  // used most in the loop in registers, as well as the instance data and the
+  // memory start if they are used. Back-edges then only have to move values
+  // that changed registers within the loop.
+  void PrepareLoopLocals(FullDecoder* decoder) {
+    uint32_t num_locals = __ num_locals();
+    if (loop_local_uses_.size() != num_locals) {
+      loop_local_uses_.resize(num_locals, 0);
+    }
+    LoopAnalysis analysis;
+    if (!AnalyzeLoop(decoder, decoder->pc(), &analysis)) {
+      for (uint32_t index : analysis.locals) loop_local_uses_[index] = 0;
+      __ SpillLocals();
+      return;
+    }
+
+    // Select the most used locals, leaving half of the cache registers for
+    // the values on the stack within the loop.
+    std::sort(analysis.locals.begin(), analysis.locals.end(),
+              [this](uint32_t a, uint32_t b) {
+                return loop_local_uses_[a] > loop_local_uses_[b];
+              });
+    int gp_budget = kLiftoffAssemblerGpCacheRegs.Count() / 2;
+    int fp_budget = kLiftoffAssemblerFpCacheRegs.Count() / 2;
+    if (analysis.uses_instance) --gp_budget;
+    if (analysis.uses_memory) --gp_budget;
+    for (uint32_t index : analysis.locals) {
+      RegClass rc = reg_class_for(__ local_kind(index));
+      int* budget = rc == kGpReg || rc == kGpRegPair ? &gp_budget : &fp_budget;
+      int needed = rc == kGpRegPair || rc == kFpRegPair ? 2 : 1;
+      if (*budget < needed) {
+        loop_local_uses_[index] = 0;
+        continue;
+      }
+      *budget -= needed;
+    }
+
+    // Spill the other locals first, to free their registers.
+    for (uint32_t i = 0; i < num_locals; ++i) {
+      if (loop_local_uses_[i] == 0) __ Spill(&__ cache_state()->stack_state[i]);
+    }
+    for (uint32_t index : analysis.locals) {
+      if (loop_local_uses_[index] == 0) continue;
+      loop_local_uses_[index] = 0;
+      __ PrepareLoopLocal(index);
+    }
+
+    LiftoffAssembler::CacheState* state = __ cache_state();
+    if (analysis.uses_instance && state->cached_instance_data == no_reg) {
+      Register instance = state->TrySetCachedInstanceRegister({});
+      if (instance != no_reg) __ LoadInstanceDataFromFrame(instance);
+    }
+    // With multiple memories, we don't know which one to cache.
+    if (analysis.uses_memory && env_->module->memories.size() == 1 &&
+        state->cached_mem_index != 0 && state->has_unused_register(kGpReg)) {
+      GetMemoryStart(0, {});
+    }
+  }
+
   void Loop(FullDecoder* decoder, Control* loop) {
     // Before entering a loop, spill all locals to the stack, in order to free
     // the cache registers, and to avoid unnecessarily reloading stack values
-    // into registers at branches.
-    // TODO(clemensb): Come up with a better strategy here, involving
-    // pre-analysis of the function.
-    __ SpillLocals();
+    // into registers at branches. With --liftoff-cache-loop-locals, the locals
+    // used most in the loop are kept in registers instead. Code for debugging
+    // keeps spilling all locals.
+    if (v8_flags.liftoff_cache_loop_locals && !for_debugging_) {
+      PrepareLoopLocals(decoder);
+    } else {
+      __ SpillLocals();
+    }
 
     __ PrepareLoopArgs(loop->start_merge.arity);
 
@@ -3368,7 +3512,8 @@ class LiftoffCompiler {
         // If index is outside the guards pages, sets index to a value that will
         // certainly cause (memory_start + offset + index) to be not accessible,
         // to make sure that the OOB access will be caught by the trap handler.
-        __ set_trap_on_oob_mem64(index_ptrsize, memory->GetMemory64GuardsSize(),
+        __ set_trap_on_oob_mem64(index_ptrsize,
+                                 WasmMemory::GetMemory64GuardedIndexLimit(),
                                  memory->max_memory_size);
       }
 
@@ -8861,6 +9006,10 @@ class LiftoffCompiler {
   ZoneVector<HandlerInfo> handlers_;
   int handler_table_offset_ = Assembler::kNoHandlerTable;
 
+  // Weighted number of accesses to each local in the loop analyzed by
+  // {AnalyzeLoop}. Reset to zero after each loop.
+  ZoneVector<uint32_t> loop_local_uses_;
+
   // Current number of exception refs on the stack.
   int num_exceptions_ = 0;
 
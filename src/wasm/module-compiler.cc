@@ -1216,6 +1216,24 @@ bool CompileLazy(Isolate* isolate,
 
   DCHECK_LE(native_module->num_imported_functions(), func_index);
   DCHECK_LT(func_index, native_module->num_functions());
+
+  // Serialized code which was not deserialized upfront is used instead of
+  // compiling the function, unless we need debug code.
+  if (native_module->lazy_deserialization_data() &&
+      is_in_debug_state == kNotDebugging) {
+    WasmCodeRefScope code_ref_scope;
+    if (WasmCode* code =
+            native_module->lazy_deserialization_data()->DeserializeFunction(
+                native_module, func_index)) {
+      TRACE_LAZY("Deserialized wasm-function#%d.\n", func_index);
+      if (V8_UNLIKELY(native_module->log_code())) {
+        GetWasmEngine()->LogCode(base::VectorOf(&code, 1));
+        GetWasmEngine()->LogOutstandingCodesForIsolate(isolate);
+      }
+      return true;
+    }
+  }
+
   WasmCompilationUnit baseline_unit{
       func_index, tiers.baseline_tier,
       is_in_debug_state ? kForDebugging : kNotForDebugging};
@@ -2007,11 +2025,13 @@ int AddExportWrapperUnits(Isolate* isolate, NativeModule* native_module,
         // Skip wrapper compilation as the wrapper is already cached.
         // Note that this does not guarantee that the wrapper is still cached
         // at the moment at which the WasmInternalFunction is instantiated.
+        isolate->counters()->wasm_export_wrapper_cache_hits()->Increment();
         continue;
       }
     }
     JSToWasmWrapperKey key(function.imported, canonical_type_index);
     if (!keys.insert(key).second) continue;  // Already triggered.
+    isolate->counters()->wasm_export_wrapper_cache_misses()->Increment();
     builder->AddJSToWasmWrapperUnit(JSToWasmWrapperCompilationUnit{
         isolate, function.sig, canonical_type_index, module, function.imported,
         native_module->enabled_features()});
@@ -2558,7 +2578,8 @@ struct ValidateFunctionsStreamingJobData {
     // delays is the right thing to do to avoid too many small validation tasks.
     // We notify on each power of two after 16 units, and every 16k units (just
     // to have *some* upper limit and avoiding to pile up too many units).
-    // Additionally, notify after receiving the last unit of the module.
+    // Additionally, notify after receiving the last unit of the module. The
+    // {AsyncStreamingProcessor} also notifies at the end of each chunk.
     if ((total_units_added >= 16 &&
          base::bits::IsPowerOfTwo(total_units_added)) ||
         (total_units_added % (16 * 1024)) == 0 || ptr == units.end()) {
@@ -2761,14 +2782,18 @@ void AsyncCompileJob::FinishCompile(bool is_after_cache_hit) {
   const WasmModule* module = native_module_->module();
   auto compilation_state = Impl(native_module_->compilation_state());
 
-  // If experimental PGO via files is enabled, load profile information now that
-  // we have all wire bytes and know that the module is valid.
+  // Load the profile information passed by the embedder (or, if experimental
+  // PGO via files is enabled, from a file) now that we have all wire bytes and
+  // know that the module is valid.
+  std::unique_ptr<ProfileInformation> pgo_info;
   if (V8_UNLIKELY(v8_flags.experimental_wasm_pgo_from_file)) {
-    std::unique_ptr<ProfileInformation> pgo_info =
-        LoadProfileFromFile(module, native_module_->wire_bytes());
-    if (pgo_info) {
-      compilation_state->ApplyPgoInfoLate(pgo_info.get());
-    }
+    pgo_info = LoadProfileFromFile(module, native_module_->wire_bytes());
+  } else if (stream_ && !stream_->profile_data().empty()) {
+    pgo_info = RestoreProfileData(module, native_module_->wire_bytes(),
+                                  stream_->profile_data());
+  }
+  if (pgo_info) {
+    compilation_state->ApplyPgoInfoLate(pgo_info.get());
   }
 
   bool is_after_deserialization = !module_object_.is_null();
@@ -3352,6 +3377,13 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(
 bool AsyncStreamingProcessor::ProcessFunctionBody(
     base::Vector<const uint8_t> bytes, uint32_t offset) {
   TRACE_STREAMING("Process function body %d ...\n", num_functions_);
+  if (validate_functions_job_data_.found_error.load(
+          std::memory_order_relaxed)) {
+    // Background validation already found an invalid function. Stop decoding
+    // and compiling the rest of the stream; the error is reported (with a
+    // deterministic message) when the stream finishes.
+    return false;
+  }
   uint32_t func_index =
       decoder_.module()->num_imported_functions + num_functions_;
   ++num_functions_;
@@ -3404,6 +3436,14 @@ void AsyncStreamingProcessor::CommitCompilationUnits() {
 void AsyncStreamingProcessor::OnFinishedChunk() {
   TRACE_STREAMING("FinishChunk...\n");
   if (compilation_unit_builder_) CommitCompilationUnits();
+  // Validation workers exit when they run out of units, and {AddUnit} only
+  // notifies at increasing intervals. Wake them up for the units of this chunk,
+  // so that validation keeps up with the download instead of piling up until
+  // the end of the stream (where the main thread waits for it).
+  if (validate_functions_job_handle_ &&
+      validate_functions_job_data_.NumOutstandingUnits() > 0) {
+    validate_functions_job_handle_->NotifyConcurrencyIncrease();
+  }
 }
 
 // Finish the processing of the stream.
@@ -4559,12 +4599,14 @@ void CompileJsToWasmWrappers(Isolate* isolate, const WasmModule* module) {
     if (existing_wrapper.IsStrongOrWeak() &&
         !IsUndefined(existing_wrapper.GetHeapObject())) {
       DCHECK(IsCodeWrapper(existing_wrapper.GetHeapObject()));
+      isolate->counters()->wasm_export_wrapper_cache_hits()->Increment();
       continue;
     }
 
     JSToWasmWrapperKey key(function.imported, canonical_type_index);
     const auto [it, inserted] = set.insert(key);
     if (!inserted) continue;  // Compilation already triggered.
+    isolate->counters()->wasm_export_wrapper_cache_misses()->Increment();
     auto unit = std::make_unique<JSToWasmWrapperCompilationUnit>(
         isolate, function.sig, canonical_type_index, module, function.imported,
         enabled_features);
@@ -1981,6 +1981,7 @@ bool InstanceBuilder::ProcessImportedFunction(
       WasmCode* wasm_code = cache->MaybeGet(kind, canonical_type_index,
                                             expected_arity, kNoSuspend);
       if (wasm_code == nullptr) {
+        isolate_->counters()->wasm_import_wrapper_cache_misses()->Increment();
         WasmCodeRefScope code_ref_scope;
         WasmImportWrapperCache::ModificationScope cache_scope(cache);
         wasm_code =
@@ -1993,6 +1994,8 @@ bool InstanceBuilder::ProcessImportedFunction(
             wasm_code->instructions().length());
         isolate_->counters()->wasm_reloc_size()->Increment(
             wasm_code->reloc_info().length());
+      } else {
+        isolate_->counters()->wasm_import_wrapper_cache_hits()->Increment();
       }
 
       // We re-use the SetWasmToJs infrastructure because it passes the
@@ -2417,8 +2420,10 @@ void InstanceBuilder::CompileImportWrappers(
                                          expected_arity, resolved.suspend());
     if (cache_scope[key] != nullptr) {
       // Cache entry already exists, no need to compile it again.
+      isolate_->counters()->wasm_import_wrapper_cache_hits()->Increment();
       continue;
     }
+    isolate_->counters()->wasm_import_wrapper_cache_misses()->Increment();
     import_wrapper_queue.insert(key, sig);
   }
 
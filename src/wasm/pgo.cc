@@ -12,17 +12,32 @@ namespace v8::internal::wasm {
 constexpr uint8_t kFunctionExecutedBit = 1 << 0;
 constexpr uint8_t kFunctionTieredUpBit = 1 << 1;
 
+// The profile data starts with the magic number, the format version, and the
+// hash of the wire bytes, so we don't apply data of another module or of an
+// older V8 version.
+constexpr uint32_t kProfileMagicNumber = 0x6f677077;  // "wpgo"
+constexpr uint32_t kProfileFormatVersion = 1;
+
+uint32_t GetProfileHash(base::Vector<const uint8_t> wire_bytes) {
+  return static_cast<uint32_t>(GetWireBytesHash(wire_bytes));
+}
+
 class ProfileGenerator {
  public:
   ProfileGenerator(const WasmModule* module,
+                   base::Vector<const uint8_t> wire_bytes,
                    const uint32_t* tiering_budget_array)
       : module_(module),
+        wire_bytes_(wire_bytes),
         type_feedback_mutex_guard_(&module->type_feedback.mutex),
         tiering_budget_array_(tiering_budget_array) {}
 
   base::OwnedVector<uint8_t> GetProfileData() {
     ZoneBuffer buffer{&zone_};
 
+    buffer.write_u32(kProfileMagicNumber);
+    buffer.write_u32(kProfileFormatVersion);
+    buffer.write_u32(GetProfileHash(wire_bytes_));
     SerializeTypeFeedback(buffer);
     SerializeTieringInfo(buffer);
 
@@ -95,65 +110,108 @@ class ProfileGenerator {
 
  private:
   const WasmModule* module_;
+  const base::Vector<const uint8_t> wire_bytes_;
   AccountingAllocator allocator_;
   Zone zone_{&allocator_, "wasm::ProfileGenerator"};
   base::SharedMutexGuard<base::kShared> type_feedback_mutex_guard_;
   const uint32_t* const tiering_budget_array_;
 };
 
-void DeserializeTypeFeedback(Decoder& decoder, const WasmModule* module) {
-  base::SharedMutexGuard<base::kShared> type_feedback_guard{
-      &module->type_feedback.mutex};
-  std::unordered_map<uint32_t, FunctionTypeFeedback>& feedback_for_function =
-      module->type_feedback.feedback_for_function;
+using TypeFeedbackEntries =
+    std::vector<std::pair<uint32_t, FunctionTypeFeedback>>;
+
+// Decodes the type feedback into {entries}. Returns false if the data is
+// invalid for {module}.
+bool DeserializeTypeFeedback(Decoder& decoder, const WasmModule* module,
+                             TypeFeedbackEntries* entries) {
+  uint32_t start = module->num_imported_functions;
+  uint32_t end = start + module->num_declared_functions;
+  uint32_t num_functions = static_cast<uint32_t>(module->functions.size());
+  // The profile comes from the embedder, so function indexes and call counts
+  // are checked before a {CallSiteFeedback} is created from them. Its encoding
+  // relies on both being non-negative.
+  auto is_valid_case = [num_functions](int function_index, int call_count) {
+    return function_index >= 0 &&
+           static_cast<uint32_t>(function_index) < num_functions &&
+           call_count >= 0;
+  };
   uint32_t num_entries = decoder.consume_u32v("num function entries");
-  CHECK_LE(num_entries, module->num_declared_functions);
+  if (num_entries > module->num_declared_functions) return false;
+  entries->reserve(num_entries);
   for (uint32_t missing_entries = num_entries; missing_entries > 0;
        --missing_entries) {
     FunctionTypeFeedback feedback;
     uint32_t function_index = decoder.consume_u32v("function index");
+    if (function_index < start || function_index >= end) return false;
     // Deserialize {feedback_vector}.
     uint32_t feedback_vector_size =
         decoder.consume_u32v("feedback vector size");
+    // Each entry takes at least one byte.
+    if (feedback_vector_size > decoder.available_bytes()) return false;
     feedback.feedback_vector.resize(feedback_vector_size);
     for (CallSiteFeedback& feedback : feedback.feedback_vector) {
       int num_cases = decoder.consume_i32v("num cases");
+      if (num_cases < 0 || num_cases > kMaxPolymorphism) return false;
       if (num_cases == 0) continue;  // no feedback
       if (num_cases == 1) {          // monomorphic
         int called_function_index = decoder.consume_i32v("function index");
         int call_count = decoder.consume_i32v("call count");
+        if (!is_valid_case(called_function_index, call_count)) return false;
         feedback = CallSiteFeedback{called_function_index, call_count};
       } else {  // polymorphic
-        auto* polymorphic = new CallSiteFeedback::PolymorphicCase[num_cases];
+        std::unique_ptr<CallSiteFeedback::PolymorphicCase[]> polymorphic{
+            new CallSiteFeedback::PolymorphicCase[num_cases]};
         for (int i = 0; i < num_cases; ++i) {
           polymorphic[i].function_index =
               decoder.consume_i32v("function index");
           polymorphic[i].absolute_call_frequency =
               decoder.consume_i32v("call count");
+          if (!is_valid_case(polymorphic[i].function_index,
+                             polymorphic[i].absolute_call_frequency)) {
+            return false;
+          }
         }
-        feedback = CallSiteFeedback{polymorphic, num_cases};
+        feedback = CallSiteFeedback{polymorphic.release(), num_cases};
       }
     }
     // Deserialize {call_targets}.
     uint32_t num_call_targets = decoder.consume_u32v("num call targets");
+    if (num_call_targets > decoder.available_bytes()) return false;
     feedback.call_targets =
         base::OwnedVector<uint32_t>::NewForOverwrite(num_call_targets);
     for (uint32_t& call_target : feedback.call_targets) {
       call_target = decoder.consume_u32v("call target");
+      if (call_target >= num_functions &&
+          call_target != FunctionTypeFeedback::kCallIndirect &&
+          call_target != FunctionTypeFeedback::kCallRef) {
+        return false;
+      }
     }
+    if (decoder.failed()) return false;
+    entries->emplace_back(function_index, std::move(feedback));
+  }
+  return true;
+}
 
-    // Finally, insert the new feedback into the map. Overwrite existing
-    // feedback, but check for consistency.
+void ApplyTypeFeedback(const WasmModule* module, TypeFeedbackEntries entries) {
+  base::SharedMutexGuard<base::kExclusive> type_feedback_guard{
+      &module->type_feedback.mutex};
+  std::unordered_map<uint32_t, FunctionTypeFeedback>& feedback_for_function =
+      module->type_feedback.feedback_for_function;
+  for (auto& [function_index, feedback] : entries) {
+    // Insert the new feedback into the map. Overwrite existing feedback if it
+    // is consistent.
     auto [feedback_it, is_new] =
         feedback_for_function.emplace(function_index, std::move(feedback));
-    if (!is_new) {
-      FunctionTypeFeedback& old_feedback = feedback_it->second;
-      CHECK(old_feedback.feedback_vector.empty() ||
-            old_feedback.feedback_vector.size() == feedback_vector_size);
-      CHECK_EQ(old_feedback.call_targets.as_vector(),
-               feedback.call_targets.as_vector());
-      std::swap(old_feedback.feedback_vector, feedback.feedback_vector);
-    }
+    if (is_new) continue;
+    FunctionTypeFeedback& old_feedback = feedback_it->second;
+    bool consistent = (old_feedback.feedback_vector.empty() ||
+                       old_feedback.feedback_vector.size() ==
+                           feedback.feedback_vector.size()) &&
+                      old_feedback.call_targets.as_vector() ==
+                          feedback.call_targets.as_vector();
+    if (!consistent) continue;
+    std::swap(old_feedback.feedback_vector, feedback.feedback_vector);
   }
 }
 
@@ -165,7 +223,7 @@ std::unique_ptr<ProfileInformation> DeserializeTieringInformation(
   uint32_t end = start + module->num_declared_functions;
   for (uint32_t func_index = start; func_index < end; ++func_index) {
     uint8_t tiering_info = decoder.consume_u8("tiering info");
-    CHECK_EQ(0, tiering_info & ~3);
+    if (tiering_info & ~3) return {};
     bool was_executed = tiering_info & kFunctionExecutedBit;
     bool was_tiered_up = tiering_info & kFunctionTieredUpBit;
     if (was_tiered_up) tiered_up_functions.push_back(func_index);
@@ -176,16 +234,33 @@ std::unique_ptr<ProfileInformation> DeserializeTieringInformation(
                                               std::move(tiered_up_functions));
 }
 
+base::OwnedVector<uint8_t> GetProfileData(
+    const WasmModule* module, base::Vector<const uint8_t> wire_bytes,
+    const uint32_t* tiering_budget_array) {
+  ProfileGenerator profile_generator{module, wire_bytes, tiering_budget_array};
+  return profile_generator.GetProfileData();
+}
+
 std::unique_ptr<ProfileInformation> RestoreProfileData(
-    const WasmModule* module, base::Vector<uint8_t> profile_data) {
+    const WasmModule* module, base::Vector<const uint8_t> wire_bytes,
+    base::Vector<const uint8_t> profile_data) {
   Decoder decoder{profile_data.begin(), profile_data.end()};
 
-  DeserializeTypeFeedback(decoder, module);
+  if (decoder.consume_u32("magic number", nullptr) != kProfileMagicNumber ||
+      decoder.consume_u32("format version", nullptr) != kProfileFormatVersion ||
+      decoder.consume_u32("wire bytes hash", nullptr) !=
+          GetProfileHash(wire_bytes)) {
+    return {};
+  }
+
+  TypeFeedbackEntries type_feedback;
+  if (!DeserializeTypeFeedback(decoder, module, &type_feedback)) return {};
   std::unique_ptr<ProfileInformation> pgo_info =
       DeserializeTieringInformation(decoder, module);
 
-  CHECK(decoder.ok());
-  CHECK_EQ(decoder.pc(), decoder.end());
+  // Only apply the type feedback if all data is valid.
+  if (!pgo_info || !decoder.ok() || decoder.pc() != decoder.end()) return {};
+  ApplyTypeFeedback(module, std::move(type_feedback));
 
   return pgo_info;
 }
@@ -201,8 +276,8 @@ void DumpProfileToFile(const WasmModule* module,
   base::EmbeddedVector<char, 32> filename;
   SNPrintF(filename, "profile-wasm-%08x", hash);
 
-  ProfileGenerator profile_generator{module, tiering_budget_array};
-  base::OwnedVector<uint8_t> profile_data = profile_generator.GetProfileData();
+  base::OwnedVector<uint8_t> profile_data =
+      GetProfileData(module, wire_bytes, tiering_budget_array);
 
   PrintF(
       "Dumping Wasm PGO data to file '%s' (module size %zu, %u declared "
@@ -247,7 +322,12 @@ std::unique_ptr<ProfileInformation> LoadProfileFromFile(
 
   base::Fclose(file);
 
-  return RestoreProfileData(module, profile_data.as_vector());
+  std::unique_ptr<ProfileInformation> pgo_info =
+      RestoreProfileData(module, wire_bytes, profile_data.as_vector());
+  if (!pgo_info) {
+    PrintF("Ignoring invalid Wasm PGO data in file '%s'\n", filename.begin());
+  }
+  return pgo_info;
 }
 
 }  // namespace v8::internal::wasm
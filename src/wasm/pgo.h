@@ -9,6 +9,7 @@
 #ifndef V8_WASM_PGO_H_
 #define V8_WASM_PGO_H_
 
+#include <memory>
 #include <vector>
 
 #include "src/base/vector.h"
@@ -40,6 +41,21 @@ class ProfileInformation {
   const std::vector<uint32_t> tiered_up_functions_;
 };
 
+// Generates profile data for the module: call counts and inlining feedback, and
+// which functions were executed and tiered up so far. The data can be passed
+// to {RestoreProfileData} for a later compilation of the same wire bytes.
+V8_EXPORT_PRIVATE base::OwnedVector<uint8_t> GetProfileData(
+    const WasmModule* module, base::Vector<const uint8_t> wire_bytes,
+    const uint32_t* tiering_budget_array);
+
+// Applies the type feedback of the given profile data to the module, and
+// returns the tiering information. Returns nullptr if the data is invalid or
+// was generated for other wire bytes.
+V8_EXPORT_PRIVATE V8_WARN_UNUSED_RESULT std::unique_ptr<ProfileInformation>
+RestoreProfileData(const WasmModule* module,
+                   base::Vector<const uint8_t> wire_bytes,
+                   base::Vector<const uint8_t> profile_data);
+
 void DumpProfileToFile(const WasmModule* module,
                        base::Vector<const uint8_t> wire_bytes,
                        uint32_t* tiering_budget_array);
@@ -4,8 +4,12 @@
 
 #include "src/wasm/stacks.h"
 
+#include <algorithm>
+
 #include "src/base/platform/platform.h"
+#include "src/execution/isolate.h"
 #include "src/execution/simulator.h"
+#include "src/logging/counters.h"
 
 namespace v8::internal::wasm {
 
@@ -19,9 +23,10 @@ StackMemory::~StackMemory() {
   if (v8_flags.trace_wasm_stack_switching) {
     PrintF("Delete stack #%d\n", id_);
   }
-  PageAllocator* allocator = GetPlatformPageAllocator();
-  if (owned_ && !allocator->DecommitPages(limit_, size_)) {
-    V8::FatalProcessOutOfMemory(nullptr, "Decommit stack memory");
+  if (owned_) {
+    isolate_->wasm_stack_pool().Add(limit_, size_);
+    isolate_->counters()->wasm_stack_memory_bytes()->Decrement(
+        static_cast<int>(size_));
   }
   // We don't need to handle removing the last stack from the list (next_ ==
   // this). This only happens on isolate tear down, otherwise there is always
@@ -45,9 +50,21 @@ StackMemory::StackMemory(Isolate* isolate) : isolate_(isolate), owned_(true) {
   int kJsStackSizeKB = v8_flags.wasm_stack_switching_stack_size;
   size_ = (kJsStackSizeKB + kJSLimitOffsetKB) * KB;
   size_ = RoundUp(size_, allocator->AllocatePageSize());
-  limit_ = static_cast<uint8_t*>(
-      allocator->AllocatePages(nullptr, size_, allocator->AllocatePageSize(),
-                               PageAllocator::kReadWrite));
+  Counters* counters = isolate->counters();
+  limit_ = isolate->wasm_stack_pool().Get(size_);
+  if (limit_ != nullptr) {
+    counters->wasm_stack_pool_hits()->Increment();
+  } else {
+    counters->wasm_stack_pool_misses()->Increment();
+    // The pages are only committed by the OS when they are first touched.
+    limit_ = static_cast<uint8_t*>(
+        allocator->AllocatePages(nullptr, size_, allocator->AllocatePageSize(),
+                                 PageAllocator::kReadWrite));
+    if (limit_ == nullptr) {
+      V8::FatalProcessOutOfMemory(nullptr, "Allocate stack memory");
+    }
+  }
+  counters->wasm_stack_memory_bytes()->Increment(static_cast<int>(size_));
   if (v8_flags.trace_wasm_stack_switching) {
     PrintF("Allocate stack #%d (limit: %p, base: %p)\n", id_, limit_,
            limit_ + size_);
@@ -60,4 +77,42 @@ StackMemory::StackMemory(Isolate* isolate, uint8_t* limit, size_t size)
   id_ = 0;
 }
 
+StackPool::~StackPool() {
+  PageAllocator* allocator = GetPlatformPageAllocator();
+  for (const Segment& segment : segments_) {
+    FreePages(allocator, segment.limit, segment.size);
+  }
+}
+
+uint8_t* StackPool::Get(size_t size) {
+  // Prefer the most recently added segment, its retained pages are the most
+  // likely to still be resident.
+  for (auto it = segments_.rbegin(); it != segments_.rend(); ++it) {
+    if (it->size != size) continue;
+    uint8_t* limit = it->limit;
+    segments_.erase(std::next(it).base());
+    size_ -= size;
+    return limit;
+  }
+  return nullptr;
+}
+
+void StackPool::Add(uint8_t* limit, size_t size) {
+  PageAllocator* allocator = GetPlatformPageAllocator();
+  if (size_ + size > v8_flags.wasm_stack_pool_max_size * KB) {
+    FreePages(allocator, limit, size);
+    return;
+  }
+  // The stack grows downwards from {limit + size}. Keep the top pages, which
+  // are used by every stack, and give the others back to the OS.
+  size_t retained = std::min(size, kRetainedSize);
+  retained = RoundUp(retained, allocator->CommitPageSize());
+  if (retained < size) {
+    // This is only a hint, the pages are just kept if it fails.
+    allocator->DiscardSystemPages(limit, size - retained);
+  }
+  segments_.push_back({limit, size});
+  size_ += size;
+}
+
 }  // namespace v8::internal::wasm
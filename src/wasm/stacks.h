@@ -9,6 +9,8 @@
 #error This header should only be included if WebAssembly is enabled.
 #endif  // !V8_ENABLE_WEBASSEMBLY
 
+#include <vector>
+
 #include "src/common/globals.h"
 #include "src/utils/allocation.h"
 
@@ -85,6 +87,39 @@ class StackMemory {
   StackMemory* prev_ = this;
 };
 
+// Keeps the memory of deleted stacks, so that new stacks can reuse it instead
+// of mapping a new segment for each suspendable call. Segments are only reused
+// for stacks of the same size, and their unused pages are discarded when they
+// are added to the pool, so that a pooled segment mostly costs address space.
+class StackPool {
+ public:
+  StackPool() = default;
+  StackPool(const StackPool&) = delete;
+  StackPool& operator=(const StackPool&) = delete;
+  ~StackPool();
+
+  // Returns a pooled segment of {size} bytes, or {nullptr} if there is none.
+  uint8_t* Get(size_t size);
+
+  // Adds a segment to the pool, or frees it if the pool is full.
+  void Add(uint8_t* limit, size_t size);
+
+  // Total size of the pooled segments.
+  size_t size() const { return size_; }
+
+  // Size of the top of a pooled stack whose pages are kept, because they are
+  // used by every stack.
+  static constexpr size_t kRetainedSize = 64 * KB;
+
+ private:
+  struct Segment {
+    uint8_t* limit;
+    size_t size;
+  };
+  std::vector<Segment> segments_;
+  size_t size_ = 0;
+};
+
 }  // namespace v8::internal::wasm
 
 #endif  // V8_WASM_STACKS_H_
@@ -99,6 +99,16 @@ class V8_EXPORT_PRIVATE StreamingDecoder {
     compiled_module_bytes_ = bytes;
   }
 
+  // Passes profile data of a previous run of the module (see
+  // {GetProfileData}). The functions that were tiered up in that run are
+  // compiled with TurboFan in the background.
+  void SetProfileData(base::OwnedVector<const uint8_t> profile_data) {
+    profile_data_ = std::move(profile_data);
+  }
+  base::Vector<const uint8_t> profile_data() const {
+    return profile_data_.as_vector();
+  }
+
   virtual void NotifyNativeModuleCreated(
       const std::shared_ptr<NativeModule>& native_module) = 0;
 
@@ -127,6 +137,7 @@ class V8_EXPORT_PRIVATE StreamingDecoder {
   // The content of `compiled_module_bytes_` shouldn't be used until
   // Finish(true) is called.
   base::Vector<const uint8_t> compiled_module_bytes_;
+  base::OwnedVector<const uint8_t> profile_data_;
 };
 
 }  // namespace wasm
@@ -11,6 +11,7 @@
 
 #include "src/base/iterator.h"
 #include "src/base/macros.h"
+#include "src/base/small-vector.h"
 #include "src/common/globals.h"
 #include "src/wasm/value-type.h"
 #include "src/zone/zone.h"
@@ -79,38 +80,49 @@ class StructType : public ZoneObject {
     if (field_count() == 0) return;
     DCHECK(!offsets_initialized_);
     uint32_t offset = field(0).value_kind_size();
-    // Optimization: we track the last gap that was introduced by alignment,
-    // and place any sufficiently-small fields in it.
+    // Optimization: we track the gaps that were introduced by alignment, and
+    // place any sufficiently-small fields in the first gap that fits them.
     // It's important that the algorithm that assigns offsets to fields is
     // subtyping-safe, i.e. two lists of fields with a common prefix must
     // always compute the same offsets for the fields in this common prefix.
-    uint32_t gap_position = 0;
-    uint32_t gap_size = 0;
+    // This is why fields are placed in declaration order, rather than e.g. by
+    // size.
+    struct Gap {
+      uint32_t position;
+      uint32_t size;
+    };
+    // Sorted by position.
+    base::SmallVector<Gap, 8> gaps;
     for (uint32_t i = 1; i < field_count(); i++) {
       uint32_t field_size = field(i).value_kind_size();
-      if (field_size <= gap_size) {
-        uint32_t aligned_gap = Align(gap_position, field_size);
-        uint32_t gap_before = aligned_gap - gap_position;
-        uint32_t aligned_gap_size = gap_size - gap_before;
-        if (field_size <= aligned_gap_size) {
-          field_offsets_[i - 1] = aligned_gap;
-          uint32_t gap_after = aligned_gap_size - field_size;
-          if (gap_before > gap_after) {
-            // Keep old {gap_position}.
-            gap_size = gap_before;
+      bool placed_in_gap = false;
+      for (Gap* gap = gaps.begin(); gap != gaps.end(); ++gap) {
+        uint32_t aligned_gap = Align(gap->position, field_size);
+        uint32_t gap_end = gap->position + gap->size;
+        if (aligned_gap + field_size > gap_end) continue;
+        field_offsets_[i - 1] = aligned_gap;
+        // Keep the parts of the gap before and after the field.
+        Gap after{aligned_gap + field_size,
+                  gap_end - aligned_gap - field_size};
+        gap->size = aligned_gap - gap->position;
+        if (gap->size == 0) {
+          if (after.size == 0) {
+            std::move(gap + 1, gaps.end(), gap);
+            gaps.pop_back();
           } else {
-            gap_position = aligned_gap + field_size;
-            gap_size = gap_after;
+            *gap = after;
           }
-          continue;  // Successfully placed the field in the gap.
+        } else if (after.size != 0) {
+          gaps.insert(gap + 1, after);
         }
+        placed_in_gap = true;
+        break;
       }
+      if (placed_in_gap) continue;
       uint32_t old_offset = offset;
       offset = Align(offset, field_size);
-      uint32_t gap = offset - old_offset;
-      if (gap > gap_size) {
-        gap_size = gap;
-        gap_position = old_offset;
+      if (offset != old_offset) {
+        gaps.push_back({old_offset, offset - old_offset});
       }
       field_offsets_[i - 1] = offset;
       offset += field_size;
@@ -43,6 +43,7 @@ using compiler::TrapId;
 using TSBlock = compiler::turboshaft::Block;
 using compiler::turboshaft::BuiltinCallDescriptor;
 using compiler::turboshaft::CallOp;
+using compiler::turboshaft::ChangeOp;
 using compiler::turboshaft::ConditionWithHint;
 using compiler::turboshaft::ConstantOp;
 using compiler::turboshaft::ConstOrV;
@@ -6680,6 +6681,31 @@ class TurboshaftGraphBuildingInterface : public WasmGraphBuilderBase {
     }
   }
 
+  // Returns whether the (memory64) {index} is statically known to be below
+  // {WasmMemory::GetMemory64GuardedIndexLimit()}. This covers the common
+  // patterns of indexes that are zero-extended from 32 bits, masked, or
+  // constant.
+  bool IsBelowMemory64GuardedIndexLimit(V<WordPtr> index) {
+    const uint64_t limit = wasm::WasmMemory::GetMemory64GuardedIndexLimit();
+    OperationMatcher matcher(__ output_graph());
+    uint64_t constant;
+    if (matcher.MatchUnsignedIntegralConstant(index, &constant)) {
+      return constant < limit;
+    }
+    V<WordPtr> masked;
+    if (matcher.MatchBitwiseAndWithConstant(index, &masked, &constant,
+                                            WordRepresentation::WordPtr())) {
+      return constant < limit;
+    }
+    OpIndex input;
+    if (matcher.MatchChange(index, &input, ChangeOp::Kind::kZeroExtend,
+                            RegisterRepresentation::Word32(),
+                            RegisterRepresentation::Word64())) {
+      return uint64_t{kMaxUInt32} < limit;
+    }
+    return false;
+  }
+
   std::pair<V<WordPtr>, compiler::BoundsCheckResult> BoundsCheckMem(
       const wasm::WasmMemory* memory, MemoryRepresentation repr, OpIndex index,
       uintptr_t offset, compiler::EnforceBoundsCheck enforce_bounds_check,
@@ -6760,10 +6786,16 @@ class TurboshaftGraphBuildingInterface : public WasmGraphBuilderBase {
         enforce_bounds_check ==
             compiler::EnforceBoundsCheck::kCanOmitBoundsCheck) {
       if (memory->is_memory64) {
+        // Like memory32 accesses, accesses whose index is known to be small
+        // enough are fully covered by the guard regions.
+        if (IsBelowMemory64GuardedIndexLimit(converted_index)) {
+          return {converted_index, compiler::BoundsCheckResult::kTrapHandler};
+        }
         Label<WordPtr> no_oom(&asm_);
-        V<Word32> cond = __ UintPtrLessThan(
-            converted_index,
-            __ UintPtrConstant(memory->GetMemory64GuardsSize()));
+        const uint64_t index_limit =
+            wasm::WasmMemory::GetMemory64GuardedIndexLimit();
+        V<Word32> cond = __ UintPtrLessThan(converted_index,
+                                            __ UintPtrConstant(index_limit));
         GOTO_IF(LIKELY(cond), no_oom, converted_index);
 
         if (static_cast<bool>(alignment_check) && align_mask != 0 &&
@@ -46,6 +46,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-objects.h"
+#include "src/wasm/wasm-serialization.h"
 #include "src/wasm/well-known-imports.h"
 
 #if defined(V8_OS_WIN64)
@@ -1739,6 +1740,12 @@ void NativeModule::SetWireBytes(base::OwnedVector<const uint8_t> wire_bytes) {
   }
 }
 
+void NativeModule::set_lazy_deserialization_data(
+    std::unique_ptr<LazyDeserializationData> data) {
+  DCHECK_NULL(lazy_deserialization_data_);
+  lazy_deserialization_data_ = std::move(data);
+}
+
 void NativeModule::AddLazyCompilationTimeSample(int64_t sample_in_micro_sec) {
   num_lazy_compilations_.fetch_add(1, std::memory_order_relaxed);
   sum_lazy_compilation_time_in_micro_sec_.fetch_add(sample_in_micro_sec,
@@ -45,6 +45,7 @@ namespace wasm {
 
 class AssumptionsJournal;
 class DebugInfo;
+class LazyDeserializationData;
 class NamesProvider;
 class NativeModule;
 struct WasmCompilationResult;
@@ -637,6 +638,12 @@ class V8_EXPORT_PRIVATE NativeModule final {
   }
   void set_lazy_compile_frozen(bool frozen) { lazy_compile_frozen_ = frozen; }
   bool lazy_compile_frozen() const { return lazy_compile_frozen_; }
+  // Set once after deserialization, before any code of the module runs.
+  void set_lazy_deserialization_data(
+      std::unique_ptr<LazyDeserializationData> data);
+  LazyDeserializationData* lazy_deserialization_data() const {
+    return lazy_deserialization_data_.get();
+  }
   base::Vector<const uint8_t> wire_bytes() const {
     return std::atomic_load(&wire_bytes_)->as_vector();
   }
@@ -981,6 +988,8 @@ class V8_EXPORT_PRIVATE NativeModule final {
   //////////////////////////////////////////////////////////////////////////////
 
   bool lazy_compile_frozen_ = false;
+  // Serialized code that is deserialized on the first call of a function.
+  std::unique_ptr<LazyDeserializationData> lazy_deserialization_data_;
   std::atomic<size_t> liftoff_bailout_count_{0};
   std::atomic<size_t> liftoff_code_size_{0};
   std::atomic<size_t> turbofan_code_size_{0};
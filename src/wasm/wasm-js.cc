@@ -96,6 +96,10 @@ class WasmStreaming::WasmStreamingImpl {
         });
   }
 
+  void SetProfileData(base::Vector<const uint8_t> bytes) {
+    streaming_decoder_->SetProfileData(base::OwnedVector<uint8_t>::Of(bytes));
+  }
+
   void SetUrl(base::Vector<const char> url) { streaming_decoder_->SetUrl(url); }
 
  private:
@@ -140,6 +144,11 @@ void WasmStreaming::SetMoreFunctionsCanBeSerializedCallback(
   impl_->SetMoreFunctionsCanBeSerializedCallback(std::move(callback));
 }
 
+void WasmStreaming::SetProfileData(const uint8_t* bytes, size_t size) {
+  TRACE_EVENT1("v8.wasm", "wasm.SetProfileData", "bytes", size);
+  impl_->SetProfileData(base::VectorOf(bytes, size));
+}
+
 void WasmStreaming::SetUrl(const char* url, size_t length) {
   DCHECK_EQ('\0', url[length]);  // {url} is null-terminated.
   TRACE_EVENT1("v8.wasm", "wasm.SetUrl", "url", url);
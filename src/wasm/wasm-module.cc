@@ -31,14 +31,17 @@ static_assert(
     std::numeric_limits<decltype(TypeDefinition().subtyping_depth)>::max());
 
 // static
-int WasmMemory::GetMemory64GuardsShift(uint64_t max_memory_size) {
-  // For memory64 we need a guard region that is at least twice the size of the
-  // maximum size of the Wasm memory. In order to speed-up bounds checks, we
-  // allocate the greater power-of-two size.
-  DCHECK_NE(max_memory_size, 0U);
-  size_t min_guards_size = 2 * max_memory_size;
+int WasmMemory::GetMemory64GuardsShift() {
+  // The accessible part of the memory is followed by a guard region that is at
+  // least as big as the maximum memory size, since offsets can be as big as
+  // that. We round up to a power of two so that the reservation size is a
+  // cheap constant in generated code.
+  uint64_t max_guarded_size =
+      std::min(uint64_t{v8_flags.wasm_memory64_guarded_max_gb} * GB,
+               uint64_t{kV8MaxWasmMemory64Pages} * kWasmPageSize);
+  uint64_t min_guards_size =
+      2 * std::max(max_guarded_size, uint64_t{kWasmPageSize});
   int guards_shift = 63 - base::bits::CountLeadingZeros64(min_guards_size);
-  DCHECK_GE(guards_shift, 0);
   if (!base::bits::IsPowerOfTwo(min_guards_size)) {
     guards_shift++;
   }
@@ -133,12 +133,21 @@ struct WasmMemory {
   uintptr_t max_memory_size = 0;  // largest size of any memory in bytes
   BoundsCheckStrategy bounds_checks = kExplicitBoundsChecks;
 
-  inline int GetMemory64GuardsShift() const {
-    return GetMemory64GuardsShift(maximum_pages * kWasmPageSize);
+  // Memory64 memories with guard regions all reserve the same power-of-two
+  // sized region, independent of their maximum size, such that code compiled
+  // for one memory can be used with any (imported) memory. The lower half
+  // holds memories of up to {GetMemory64MaxGuardedSize()} bytes.
+  static int GetMemory64GuardsShift();
+  static uint64_t GetMemory64GuardsSize() {
+    return uint64_t{1} << GetMemory64GuardsShift();
   }
-  static int GetMemory64GuardsShift(uint64_t max_memory_size);
-  inline uint64_t GetMemory64GuardsSize() const {
-    return 1ull << GetMemory64GuardsShift();
+  static uint64_t GetMemory64MaxGuardedSize() {
+    return GetMemory64GuardsSize() / 2;
+  }
+  // Accesses with an index below this limit stay within the reservation for
+  // any statically valid offset, so they do not need an explicit check.
+  static uint64_t GetMemory64GuardedIndexLimit() {
+    return GetMemory64MaxGuardedSize();
   }
 };
 
@@ -163,6 +172,11 @@ inline void UpdateComputedInformation(WasmMemory* memory, ModuleOrigin origin) {
   } else if (memory->is_memory64 && !v8_flags.wasm_memory64_trap_handling) {
     // Memory64 currently always requires explicit bounds checks.
     memory->bounds_checks = kExplicitBoundsChecks;
+  } else if (memory->is_memory64 &&
+             memory->max_memory_size >
+                 WasmMemory::GetMemory64MaxGuardedSize()) {
+    // The memory can grow beyond the region reserved for memory64 guards.
+    memory->bounds_checks = kExplicitBoundsChecks;
   } else if (trap_handler::IsTrapHandlerEnabled()) {
     if constexpr (kSystemPointerSize == 4) UNREACHABLE();
     memory->bounds_checks = kTrapHandler;
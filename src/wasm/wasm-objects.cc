@@ -530,6 +530,7 @@ void WasmTableObject::UpdateDispatchTables(
     wasm::WasmCode* wasm_code = cache->MaybeGet(kind, canonical_type_index,
                                                 param_count, wasm::kNoSuspend);
     if (wasm_code == nullptr) {
+      isolate->counters()->wasm_import_wrapper_cache_misses()->Increment();
       wasm::WasmCodeRefScope code_ref_scope;
       wasm::WasmImportWrapperCache::ModificationScope cache_scope(cache);
       wasm_code = compiler::CompileWasmCapiCallWrapper(native_module, &sig);
@@ -541,6 +542,8 @@ void WasmTableObject::UpdateDispatchTables(
           wasm_code->instructions().length());
       isolate->counters()->wasm_reloc_size()->Increment(
           wasm_code->reloc_info().length());
+    } else {
+      isolate->counters()->wasm_import_wrapper_cache_hits()->Increment();
     }
     Tagged<HeapObject> ref =
         capi_function->shared()->wasm_capi_function_data()->internal()->ref();
@@ -1519,12 +1522,14 @@ Handle<JSFunction> WasmInternalFunction::GetOrCreateExternal(
   DCHECK(entry.IsCleared() || IsUndefined(entry.GetHeapObject()) ||
          IsCodeWrapper(entry.GetHeapObject()));
   if (entry.IsStrongOrWeak() && IsCodeWrapper(entry.GetHeapObject())) {
+    isolate->counters()->wasm_export_wrapper_cache_hits()->Increment();
     wrapper_code = direct_handle(
         CodeWrapper::cast(entry.GetHeapObject())->code(isolate), isolate);
   } else if (!function.imported &&
              CanUseGenericJsToWasmWrapper(module, function.sig)) {
     wrapper_code = isolate->builtins()->code_handle(Builtin::kJSToWasmWrapper);
   } else {
+    isolate->counters()->wasm_export_wrapper_cache_misses()->Increment();
     // The wrapper may not exist yet if no function in the exports section has
     // this signature. We compile it and store the wrapper in the module for
     // later use.
@@ -1654,10 +1659,12 @@ void WasmTrustedInstanceData::ImportWasmJSFunctionIntoTable(
       cache->MaybeGet(kind, canonical_sig_index, expected_arity, suspend);
   Address call_target;
   if (wasm_code) {
+    isolate->counters()->wasm_import_wrapper_cache_hits()->Increment();
     call_target = wasm_code->instruction_start();
   } else if (UseGenericWasmToJSWrapper(kind, sig, resolved.suspend())) {
     call_target = Builtins::EntryOf(Builtin::kWasmToJsWrapperAsm, isolate);
   } else {
+    isolate->counters()->wasm_import_wrapper_cache_misses()->Increment();
     wasm::CompilationEnv env = wasm::CompilationEnv::ForModule(native_module);
     wasm::WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
         &env, kind, sig, false, expected_arity, suspend);
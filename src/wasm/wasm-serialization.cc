@@ -4,11 +4,13 @@
 
 #include "src/wasm/wasm-serialization.h"
 
+#include "src/base/container-utils.h"
 #include "src/codegen/assembler-arch.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/debug/debug.h"
 #include "src/runtime/runtime.h"
 #include "src/snapshot/snapshot-data.h"
+#include "src/snapshot/snapshot-utils.h"
 #include "src/utils/ostreams.h"
 #include "src/utils/version.h"
 #include "src/wasm/code-space-access.h"
@@ -31,6 +33,8 @@ namespace {
 constexpr uint8_t kLazyFunction = 2;
 constexpr uint8_t kEagerFunction = 3;
 constexpr uint8_t kTurboFanFunction = 4;
+// Starts a section of code that was appended to an existing serialization.
+constexpr uint32_t kAppendedCodeMarker = 0xa99e4dc0;
 
 // TODO(bbudge) Try to unify the various implementations of readers and writers
 // in Wasm, e.g. StreamProcessor and ZoneBuffer, with these.
@@ -214,6 +218,49 @@ constexpr size_t kCodeHeaderSize = sizeof(uint8_t) +  // code kind
                                    sizeof(WasmCode::Kind) +  // code kind
                                    sizeof(ExecutionTier);    // tier
 
+constexpr size_t kAppendedCodeHeaderSize =
+    sizeof(uint32_t) +  // marker
+    sizeof(size_t) +    // total code size
+    sizeof(uint32_t);   // number of functions
+
+// Skips the code of a {kTurboFanFunction} after its marker, and stores the
+// size of its instructions in {code_size}. Returns false, with {reader} at an
+// unspecified position, if the code does not fit into the remaining data.
+bool SkipCode(Reader* reader, size_t* code_size) {
+  if (reader->current_size() < kCodeHeaderSize - sizeof(uint8_t)) return false;
+  // Skip all offsets, the unpadded binary size and the slot counts.
+  reader->Skip(8 * sizeof(int));
+  int sizes[] = {
+      reader->Read<int>(),  // code size
+      reader->Read<int>(),  // reloc size
+      reader->Read<int>(),  // source positions size
+      reader->Read<int>(),  // inlining positions size
+      reader->Read<int>(),  // deopt data size
+      reader->Read<int>(),  // protected instructions size
+  };
+  reader->Skip(sizeof(WasmCode::Kind) + sizeof(ExecutionTier));
+  size_t total_size = 0;
+  for (int size : sizes) {
+    if (size < 0) return false;
+    total_size += static_cast<size_t>(size);
+  }
+  if (total_size > reader->current_size()) return false;
+  reader->Skip(total_size);
+  *code_size = static_cast<size_t>(sizes[0]);
+  return IsAligned(*code_size, kCodeAlignment);
+}
+
+// Returns true if {reader} is at a valid function entry which fits into the
+// remaining data, and whose code fits into {remaining_code_size} bytes.
+bool CanReadFunction(Reader reader, size_t remaining_code_size) {
+  if (reader.current_size() == 0) return false;
+  uint8_t code_kind = reader.Read<uint8_t>();
+  if (code_kind == kLazyFunction || code_kind == kEagerFunction) return true;
+  if (code_kind != kTurboFanFunction) return false;
+  size_t code_size;
+  return SkipCode(&reader, &code_size) && code_size <= remaining_code_size;
+}
+
 // A List of all isolate-independent external references. This is used to create
 // a tag from the Address of an external reference and vice versa.
 class ExternalReferenceList {
@@ -293,7 +340,13 @@ class V8_EXPORT_PRIVATE NativeModuleSerializer {
   size_t Measure() const;
   bool Write(Writer* writer);
 
+  // Measure and write a section with the code of all TurboFan functions that
+  // are not {serialized} yet.
+  size_t MeasureAppendedCode(const std::vector<bool>& serialized) const;
+  bool WriteAppendedCode(Writer* writer, const std::vector<bool>& serialized);
+
  private:
+  bool ShouldAppend(const WasmCode*, const std::vector<bool>& serialized) const;
   size_t MeasureCode(const WasmCode*) const;
   void WriteHeader(Writer*, size_t total_code_size);
   void WriteCode(const WasmCode*, Writer*);
@@ -530,8 +583,126 @@ bool NativeModuleSerializer::Write(Writer* writer) {
   return true;
 }
 
+bool NativeModuleSerializer::ShouldAppend(
+    const WasmCode* code, const std::vector<bool>& serialized) const {
+  if (code == nullptr || code->tier() != ExecutionTier::kTurbofan) return false;
+  return !serialized[declared_function_index(native_module_->module(),
+                                             code->index())];
+}
+
+size_t NativeModuleSerializer::MeasureAppendedCode(
+    const std::vector<bool>& serialized) const {
+  size_t size = kAppendedCodeHeaderSize;
+  for (WasmCode* code : code_table_) {
+    if (!ShouldAppend(code, serialized)) continue;
+    size += sizeof(uint32_t) + MeasureCode(code);
+  }
+  return size;
+}
+
+bool NativeModuleSerializer::WriteAppendedCode(
+    Writer* writer, const std::vector<bool>& serialized) {
+  DCHECK(!write_called_);
+  write_called_ = true;
+
+  size_t total_code_size = 0;
+  uint32_t num_functions = 0;
+  for (WasmCode* code : code_table_) {
+    if (!ShouldAppend(code, serialized)) continue;
+    total_code_size += code->instructions().size();
+    ++num_functions;
+  }
+  // Don't append an empty section.
+  if (num_functions == 0) return false;
+
+  writer->Write(kAppendedCodeMarker);
+  writer->Write(total_code_size);
+  writer->Write(num_functions);
+  for (WasmCode* code : code_table_) {
+    if (!ShouldAppend(code, serialized)) continue;
+    writer->Write(static_cast<uint32_t>(code->index()));
+    WriteCode(code, writer);
+  }
+  DCHECK_EQ(num_functions, num_turbofan_functions_);
+  CHECK_EQ(total_written_code_, total_code_size);
+  return true;
+}
+
+namespace {
+
+// Finds the declared functions that have code in the {data} serialized for
+// {native_module}. Returns false if {data} is not a valid serialization of the
+// module.
+bool FindSerializedFunctions(const NativeModule* native_module,
+                             base::Vector<const uint8_t> data,
+                             std::vector<bool>* serialized) {
+  if (!IsSupportedVersion(data, native_module->enabled_features())) {
+    return false;
+  }
+  const WasmModule* module = native_module->module();
+  Reader reader(data + WasmSerializer::kHeaderSize);
+
+  // Skip the header written by {NativeModuleSerializer::WriteHeader}.
+  size_t header_size = sizeof(CompileTimeImports::StorageType) + kHeaderSize +
+                       module->num_imported_functions * sizeof(WellKnownImport);
+  if (reader.current_size() < header_size) return false;
+  auto compile_imports = reader.Read<CompileTimeImports::StorageType>();
+  if (compile_imports != native_module->compile_imports().ToIntegral()) {
+    return false;
+  }
+  reader.Skip(header_size - sizeof(CompileTimeImports::StorageType));
+
+  serialized->assign(module->num_declared_functions, false);
+  size_t code_size;
+  for (uint32_t i = 0; i < module->num_declared_functions; ++i) {
+    if (reader.current_size() == 0) return false;
+    uint8_t code_kind = reader.Read<uint8_t>();
+    if (code_kind == kLazyFunction || code_kind == kEagerFunction) continue;
+    if (code_kind != kTurboFanFunction) return false;
+    if (!SkipCode(&reader, &code_size)) return false;
+    (*serialized)[i] = true;
+  }
+
+  size_t size_of_tiering_budget =
+      module->num_declared_functions * sizeof(uint32_t);
+  if (size_of_tiering_budget <= reader.current_size()) {
+    reader.Skip(size_of_tiering_budget);
+  }
+
+  while (reader.current_size() > 0) {
+    if (reader.current_size() < kAppendedCodeHeaderSize) return false;
+    if (reader.Read<uint32_t>() != kAppendedCodeMarker) return false;
+    reader.Skip(sizeof(size_t));
+    uint32_t num_functions = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < num_functions; ++i) {
+      if (reader.current_size() < sizeof(uint32_t) + sizeof(uint8_t)) {
+        return false;
+      }
+      uint32_t func_index = reader.Read<uint32_t>();
+      if (func_index < module->num_imported_functions ||
+          func_index >= native_module->num_functions()) {
+        return false;
+      }
+      int declared_index = declared_function_index(module, func_index);
+      if ((*serialized)[declared_index]) return false;
+      if (reader.Read<uint8_t>() != kTurboFanFunction) return false;
+      if (!SkipCode(&reader, &code_size)) return false;
+      (*serialized)[declared_index] = true;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 WasmSerializer::WasmSerializer(NativeModule* native_module)
     : native_module_(native_module) {
+  // Functions whose serialized code is still pending have no code yet, and
+  // would be serialized as lazy functions.
+  if (LazyDeserializationData* lazy_data =
+          native_module->lazy_deserialization_data()) {
+    lazy_data->DeserializeAllFunctions(native_module);
+  }
   std::tie(code_table_, import_statuses_) = native_module->SnapshotCodeTable();
 }
 
@@ -555,6 +726,39 @@ bool WasmSerializer::SerializeNativeModule(base::Vector<uint8_t> buffer) const {
   return true;
 }
 
+size_t WasmSerializer::GetAppendedCodeSize(
+    base::Vector<const uint8_t> serialized) const {
+  std::vector<bool> serialized_functions;
+  if (!FindSerializedFunctions(native_module_, serialized,
+                               &serialized_functions)) {
+    return 0;
+  }
+  NativeModuleSerializer serializer(native_module_, base::VectorOf(code_table_),
+                                    base::VectorOf(import_statuses_));
+  return serializer.MeasureAppendedCode(serialized_functions);
+}
+
+bool WasmSerializer::SerializeAppendedCode(
+    base::Vector<const uint8_t> serialized,
+    base::Vector<uint8_t> buffer) const {
+  std::vector<bool> serialized_functions;
+  if (!FindSerializedFunctions(native_module_, serialized,
+                               &serialized_functions)) {
+    return false;
+  }
+  NativeModuleSerializer serializer(native_module_, base::VectorOf(code_table_),
+                                    base::VectorOf(import_statuses_));
+  size_t measured_size = serializer.MeasureAppendedCode(serialized_functions);
+  if (buffer.size() < measured_size) return false;
+
+  Writer writer(buffer);
+  if (!serializer.WriteAppendedCode(&writer, serialized_functions)) {
+    return false;
+  }
+  DCHECK_EQ(measured_size, writer.bytes_written());
+  return true;
+}
+
 struct DeserializationUnit {
   base::Vector<const uint8_t> src_code_buffer;
   std::unique_ptr<WasmCode> code;
@@ -602,12 +806,17 @@ class DeserializationQueue {
 
 class V8_EXPORT_PRIVATE NativeModuleDeserializer {
  public:
-  explicit NativeModuleDeserializer(NativeModule*);
+  // If {lazy_data} is non-null, TurboFan code is not deserialized but
+  // registered there, to be deserialized on the first call of each function.
+  NativeModuleDeserializer(NativeModule*, LazyDeserializationData* lazy_data);
   NativeModuleDeserializer(const NativeModuleDeserializer&) = delete;
   NativeModuleDeserializer& operator=(const NativeModuleDeserializer&) = delete;
 
   bool Read(Reader* reader);
 
+  // Deserializes and publishes the code of a single function.
+  WasmCode* ReadFunction(int fn_index, Reader* reader);
+
   base::Vector<const int> lazy_functions() {
     return base::VectorOf(lazy_functions_);
   }
@@ -623,9 +832,10 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   DeserializationUnit ReadCode(int fn_index, Reader* reader);
   void ReadTieringBudget(Reader* reader);
   void CopyAndRelocate(const DeserializationUnit& unit);
-  void Publish(std::vector<DeserializationUnit> batch);
+  std::vector<WasmCode*> Publish(std::vector<DeserializationUnit> batch);
 
   NativeModule* const native_module_;
+  LazyDeserializationData* const lazy_data_;
 #ifdef DEBUG
   bool read_called_ = false;
 #endif
@@ -638,6 +848,10 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   NativeModule::JumpTablesRef current_jump_tables_;
   std::vector<int> lazy_functions_;
   std::vector<int> eager_functions_;
+  // Functions whose TurboFan code is registered in {lazy_data_}.
+  std::vector<int> lazily_deserialized_functions_;
+  // Per declared function, whether TurboFan code was read for it.
+  std::vector<bool> has_code_;
 };
 
 class DeserializeCodeTask : public JobTask {
@@ -701,8 +915,9 @@ class DeserializeCodeTask : public JobTask {
   std::atomic<bool> publishing_{false};
 };
 
-NativeModuleDeserializer::NativeModuleDeserializer(NativeModule* native_module)
-    : native_module_(native_module) {}
+NativeModuleDeserializer::NativeModuleDeserializer(
+    NativeModule* native_module, LazyDeserializationData* lazy_data)
+    : native_module_(native_module), lazy_data_(lazy_data) {}
 
 bool NativeModuleDeserializer::Read(Reader* reader) {
   DCHECK(!read_called_);
@@ -710,11 +925,18 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
   read_called_ = true;
 #endif
 
+  const WasmModule* module = native_module_->module();
+  if (reader->current_size() <
+      sizeof(CompileTimeImports::StorageType) + kHeaderSize +
+          module->num_imported_functions * sizeof(WellKnownImport)) {
+    return false;
+  }
   ReadHeader(reader);
   if (compile_imports_ != native_module_->compile_imports()) return false;
 
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
+  has_code_.assign(module->num_declared_functions, false);
 
   if (all_functions_validated_) {
     native_module_->module()->set_all_functions_validated();
@@ -738,9 +960,15 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
 
   std::vector<DeserializationUnit> batch;
   size_t batch_size = 0;
-  for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    DeserializationUnit unit = ReadCode(i, reader);
-    if (!unit.code) continue;
+  // The data comes from the embedder, so every function is checked to fit
+  // into the remaining data and code space before it is read.
+  auto read_function = [&](int fn_index) {
+    if (!CanReadFunction(*reader, remaining_code_size_)) return false;
+    if (*reader->current_location() == kTurboFanFunction) {
+      has_code_[declared_function_index(module, fn_index)] = true;
+    }
+    DeserializationUnit unit = ReadCode(fn_index, reader);
+    if (!unit.code) return true;
     batch_size += unit.code->instructions().size();
     batch.emplace_back(std::move(unit));
     if (batch_size >= batch_limit) {
@@ -749,12 +977,49 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
       batch_size = 0;
       job_handle->NotifyConcurrencyIncrease();
     }
+    return true;
+  };
+  bool success = true;
+  for (uint32_t i = first_wasm_fn; success && i < total_fns; ++i) {
+    success = read_function(i);
   }
 
   // We should have read the expected amount of code now, and should have fully
   // utilized the allocated code space.
-  DCHECK_EQ(0, remaining_code_size_);
-  DCHECK_EQ(0, current_code_space_.size());
+  success = success && remaining_code_size_ == 0;
+  DCHECK_IMPLIES(success, current_code_space_.empty());
+
+  if (success) ReadTieringBudget(reader);
+
+  // Read the sections of code that were appended to the serialization (see
+  // {WasmSerializer::SerializeAppendedCode}). Each section only contains
+  // TurboFan code of functions that had no code before.
+  while (success && reader->current_size() > 0) {
+    if (reader->current_size() < kAppendedCodeHeaderSize ||
+        reader->Read<uint32_t>() != kAppendedCodeMarker) {
+      success = false;
+      break;
+    }
+    remaining_code_size_ = reader->Read<size_t>();
+    uint32_t num_functions = reader->Read<uint32_t>();
+    for (uint32_t i = 0; success && i < num_functions; ++i) {
+      if (reader->current_size() < sizeof(uint32_t)) {
+        success = false;
+        break;
+      }
+      uint32_t fn_index = reader->Read<uint32_t>();
+      if (fn_index < first_wasm_fn || fn_index >= total_fns ||
+          has_code_[declared_function_index(module, fn_index)] ||
+          reader->current_size() == 0 ||
+          *reader->current_location() != kTurboFanFunction) {
+        success = false;
+        break;
+      }
+      success = read_function(fn_index);
+    }
+    success = success && remaining_code_size_ == 0;
+    DCHECK_IMPLIES(success, current_code_space_.empty());
+  }
 
   if (!batch.empty()) {
     reloc_queue.Add(std::move(batch));
@@ -763,9 +1028,35 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
 
   // Wait for all tasks to finish, while participating in their work.
   job_handle->Join();
+  if (!success) return false;
 
-  ReadTieringBudget(reader);
-  return reader->current_size() == 0;
+  // Functions that got code in an appended section were serialized as lazy or
+  // eager functions before.
+  auto has_code = [&](int fn_index) {
+    return has_code_[declared_function_index(module, fn_index)];
+  };
+  base::erase_if(lazy_functions_, has_code);
+  base::erase_if(eager_functions_, has_code);
+  lazy_functions_.insert(lazy_functions_.end(),
+                         lazily_deserialized_functions_.begin(),
+                         lazily_deserialized_functions_.end());
+  return true;
+}
+
+WasmCode* NativeModuleDeserializer::ReadFunction(int fn_index,
+                                                 Reader* reader) {
+  DCHECK_NULL(lazy_data_);
+  DCHECK_EQ(kTurboFanFunction, *reader->current_location());
+  // Peek at the code size, to allocate code space for just this function.
+  Reader code_header_reader = *reader;
+  code_header_reader.Skip(sizeof(uint8_t) + 8 * sizeof(int));
+  remaining_code_size_ = code_header_reader.Read<int>();
+
+  std::vector<DeserializationUnit> batch;
+  batch.emplace_back(ReadCode(fn_index, reader));
+  DCHECK_EQ(0, remaining_code_size_);
+  CopyAndRelocate(batch[0]);
+  return Publish(std::move(batch))[0];
 }
 
 void NativeModuleDeserializer::ReadHeader(Reader* reader) {
@@ -786,6 +1077,7 @@ void NativeModuleDeserializer::ReadHeader(Reader* reader) {
 
 DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
                                                        Reader* reader) {
+  const uint8_t* code_start = reader->current_location();
   uint8_t code_kind = reader->Read<uint8_t>();
   if (code_kind == kLazyFunction) {
     lazy_functions_.push_back(fn_index);
@@ -795,6 +1087,21 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
     eager_functions_.push_back(fn_index);
     return {};
   }
+  DCHECK_EQ(kTurboFanFunction, code_kind);
+
+  if (lazy_data_ != nullptr) {
+    // {Read} checked that the code fits.
+    size_t code_size;
+    CHECK(SkipCode(reader, &code_size));
+    lazy_data_->AddFunction(
+        declared_function_index(native_module_->module(), fn_index),
+        static_cast<size_t>(code_start - lazy_data_->data().begin()),
+        static_cast<size_t>(reader->current_location() - code_start));
+    DCHECK_GE(remaining_code_size_, code_size);
+    remaining_code_size_ -= code_size;
+    lazily_deserialized_functions_.push_back(fn_index);
+    return {};
+  }
 
   int constant_pool_offset = reader->Read<int>();
   int safepoint_table_offset = reader->Read<int>();
@@ -926,7 +1233,8 @@ void NativeModuleDeserializer::ReadTieringBudget(Reader* reader) {
          size_of_tiering_budget);
 }
 
-void NativeModuleDeserializer::Publish(std::vector<DeserializationUnit> batch) {
+std::vector<WasmCode*> NativeModuleDeserializer::Publish(
+    std::vector<DeserializationUnit> batch) {
   DCHECK(!batch.empty());
   std::vector<std::unique_ptr<WasmCode>> codes;
   codes.reserve(batch.size());
@@ -938,6 +1246,78 @@ void NativeModuleDeserializer::Publish(std::vector<DeserializationUnit> batch) {
     wasm_code->MaybePrint();
     wasm_code->Validate();
   }
+  return published_codes;
+}
+
+LazyDeserializationData::LazyDeserializationData(
+    base::OwnedVector<const uint8_t> data, uint32_t num_declared_functions)
+    : owned_data_(std::move(data)),
+      data_(owned_data_.as_vector()),
+      pending_functions_(num_declared_functions) {}
+
+LazyDeserializationData::LazyDeserializationData(
+    std::unique_ptr<base::OS::MemoryMappedFile> mapped_file,
+    uint32_t num_declared_functions)
+    : mapped_file_(std::move(mapped_file)),
+      data_(reinterpret_cast<const uint8_t*>(mapped_file_->memory()),
+            mapped_file_->size()),
+      pending_functions_(num_declared_functions) {}
+
+void LazyDeserializationData::AddFunction(int declared_index, size_t offset,
+                                          size_t size) {
+  DCHECK_LT(0, offset);
+  DCHECK_LE(offset + size, data_.size());
+  PendingFunction& pending = pending_functions_[declared_index];
+  DCHECK_EQ(0, pending.offset);
+  pending.offset = offset;
+  pending.size = size;
+  // The file can change after loading, so remember what was validated.
+  if (mapped_file_) {
+    pending.checksum = Checksum(data_.SubVector(offset, offset + size));
+  }
+  ++num_remaining_functions_;
+}
+
+WasmCode* LazyDeserializationData::DeserializeFunction(
+    NativeModule* native_module, int func_index) {
+  base::MutexGuard guard(&mutex_);
+  PendingFunction& pending = pending_functions_[declared_function_index(
+      native_module->module(), func_index)];
+  if (pending.offset == 0) return nullptr;
+  base::Vector<const uint8_t> code =
+      data_.SubVector(pending.offset, pending.offset + pending.size);
+  pending.offset = 0;
+
+  // Read from a private copy of the code in a mapped file, so it cannot change
+  // between checking and deserializing it. If it changed since loading, return
+  // nullptr to compile the function instead.
+  base::OwnedVector<const uint8_t> copy;
+  if (mapped_file_) {
+    copy = base::OwnedVector<uint8_t>::Of(code);
+    code = copy.as_vector();
+    if (Checksum(code) != pending.checksum) code = {};
+  }
+  WasmCode* result = nullptr;
+  if (!code.empty()) {
+    Reader reader(code);
+    NativeModuleDeserializer deserializer(native_module, nullptr);
+    result = deserializer.ReadFunction(func_index, &reader);
+  }
+  // Free the serialized data once all functions were deserialized.
+  if (--num_remaining_functions_ == 0) {
+    data_ = {};
+    owned_data_ = base::OwnedVector<uint8_t>{};
+    mapped_file_.reset();
+  }
+  return result;
+}
+
+void LazyDeserializationData::DeserializeAllFunctions(
+    NativeModule* native_module) {
+  const WasmModule* module = native_module->module();
+  for (uint32_t i = 0; i < module->num_declared_functions; ++i) {
+    DeserializeFunction(native_module, module->num_imported_functions + i);
+  }
 }
 
 bool IsSupportedVersion(base::Vector<const uint8_t> header,
@@ -950,8 +1330,12 @@ bool IsSupportedVersion(base::Vector<const uint8_t> header,
          0;
 }
 
-MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+namespace {
+
+// If {mapped_file} is non-null, it holds the memory of {data}.
+MaybeHandle<WasmModuleObject> DeserializeNativeModuleImpl(
     Isolate* isolate, base::Vector<const uint8_t> data,
+    std::unique_ptr<base::OS::MemoryMappedFile> mapped_file,
     base::Vector<const uint8_t> wire_bytes_vec,
     CompileTimeImports compile_imports, base::Vector<const char> source_url) {
   WasmFeatures enabled_features = WasmFeatures::FromIsolate(isolate);
@@ -991,7 +1375,22 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     shared_native_module->compilation_state()->set_compilation_id(-2);
     shared_native_module->SetWireBytes(std::move(owned_wire_bytes));
 
-    NativeModuleDeserializer deserializer(shared_native_module.get());
+    // With lazy deserialization, keep the mapped file or a copy of the
+    // serialized data to deserialize functions from on their first call.
+    std::unique_ptr<LazyDeserializationData> lazy_data;
+    if (v8_flags.wasm_lazy_deserialization) {
+      uint32_t num_declared_functions =
+          shared_native_module->module()->num_declared_functions;
+      lazy_data = mapped_file ? std::make_unique<LazyDeserializationData>(
+                                    std::move(mapped_file),
+                                    num_declared_functions)
+                              : std::make_unique<LazyDeserializationData>(
+                                    base::OwnedVector<uint8_t>::Of(data),
+                                    num_declared_functions);
+      data = lazy_data->data();
+    }
+    NativeModuleDeserializer deserializer(shared_native_module.get(),
+                                          lazy_data.get());
     Reader reader(data + WasmSerializer::kHeaderSize);
     bool error = !deserializer.Read(&reader);
     if (error) {
@@ -999,6 +1398,10 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
           error, std::move(shared_native_module), isolate);
       return {};
     }
+    if (lazy_data && !lazy_data->empty()) {
+      shared_native_module->set_lazy_deserialization_data(
+          std::move(lazy_data));
+    }
     shared_native_module->compilation_state()->InitializeAfterDeserialization(
         deserializer.lazy_functions(), deserializer.eager_functions());
     wasm_engine->UpdateNativeModuleCache(error, shared_native_module, isolate);
@@ -1018,6 +1421,31 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
   return module_object;
 }
 
+}  // namespace
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, base::Vector<const uint8_t> data,
+    base::Vector<const uint8_t> wire_bytes, CompileTimeImports compile_imports,
+    base::Vector<const char> source_url) {
+  return DeserializeNativeModuleImpl(isolate, data, nullptr, wire_bytes,
+                                     compile_imports, source_url);
+}
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModuleFromFile(
+    Isolate* isolate, const char* filename,
+    base::Vector<const uint8_t> wire_bytes, CompileTimeImports compile_imports,
+    base::Vector<const char> source_url) {
+  std::unique_ptr<base::OS::MemoryMappedFile> mapped_file{
+      base::OS::MemoryMappedFile::open(
+          filename, base::OS::MemoryMappedFile::FileMode::kReadOnly)};
+  if (!mapped_file) return {};
+  base::Vector<const uint8_t> data{
+      reinterpret_cast<const uint8_t*>(mapped_file->memory()),
+      mapped_file->size()};
+  return DeserializeNativeModuleImpl(isolate, data, std::move(mapped_file),
+                                     wire_bytes, compile_imports, source_url);
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
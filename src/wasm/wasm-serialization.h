@@ -9,6 +9,8 @@
 #ifndef V8_WASM_WASM_SERIALIZATION_H_
 #define V8_WASM_WASM_SERIALIZATION_H_
 
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-objects.h"
 
@@ -28,6 +30,20 @@ class V8_EXPORT_PRIVATE WasmSerializer {
   // success and false if the given buffer it too small for serialization.
   bool SerializeNativeModule(base::Vector<uint8_t> buffer) const;
 
+  // Measure the required buffer size for appending the code of all functions
+  // that are not contained in the {serialized} data yet. Returns 0 if
+  // {serialized} is not a valid serialization of this module.
+  size_t GetAppendedCodeSize(base::Vector<const uint8_t> serialized) const;
+
+  // Serialize the code of all TurboFan functions that are not contained in the
+  // {serialized} data yet into the provided {buffer}. Appending {buffer} to
+  // {serialized} yields a valid serialization of the module, so embedders can
+  // update a cache entry as more functions tier up without rewriting it.
+  // Returns false if {serialized} is not a valid serialization of this
+  // module, if there is no new code, or if {buffer} is too small.
+  bool SerializeAppendedCode(base::Vector<const uint8_t> serialized,
+                             base::Vector<uint8_t> buffer) const;
+
   // The data header consists of uint32_t-sized entries (see {WriteVersion}):
   // [0] magic number
   // [1] version hash
@@ -36,6 +52,7 @@ class V8_EXPORT_PRIVATE WasmSerializer {
   // [4] enabled features (via flags and OT)
   // ...  number of functions
   // ... serialized functions
+  // ... sections of appended code (see {SerializeAppendedCode})
   static constexpr size_t kMagicNumberOffset = 0;
   static constexpr size_t kVersionHashOffset = kMagicNumberOffset + kUInt32Size;
   static constexpr size_t kSupportedCPUFeaturesOffset =
@@ -52,6 +69,52 @@ class V8_EXPORT_PRIVATE WasmSerializer {
   std::vector<WellKnownImport> import_statuses_;
 };
 
+// The serialized code of functions that is only deserialized when the
+// function is called for the first time (see --wasm-lazy-deserialization).
+// Owned by the {NativeModule}; it keeps a copy or a read-only mapping of the
+// serialized data until all functions were deserialized.
+class LazyDeserializationData {
+ public:
+  LazyDeserializationData(base::OwnedVector<const uint8_t> data,
+                          uint32_t num_declared_functions);
+  LazyDeserializationData(
+      std::unique_ptr<base::OS::MemoryMappedFile> mapped_file,
+      uint32_t num_declared_functions);
+  LazyDeserializationData(const LazyDeserializationData&) = delete;
+  LazyDeserializationData& operator=(const LazyDeserializationData&) = delete;
+
+  base::Vector<const uint8_t> data() const { return data_; }
+
+  // Registers the serialized code of {size} bytes at {offset} into {data()}
+  // for the function with the given declared index.
+  void AddFunction(int declared_index, size_t offset, size_t size);
+  bool empty() const { return num_remaining_functions_ == 0; }
+
+  // Deserializes and publishes the code of the function with the given index,
+  // if it is still pending. Returns nullptr otherwise, or if the code in a
+  // mapped file changed since it was loaded.
+  WasmCode* DeserializeFunction(NativeModule* native_module, int func_index);
+  // Deserializes and publishes the code of all pending functions, e.g. so
+  // that it is included when the module is serialized again.
+  void DeserializeAllFunctions(NativeModule* native_module);
+
+ private:
+  base::Mutex mutex_;
+  // Either {owned_data_} or {mapped_file_} holds the memory of {data_}.
+  base::OwnedVector<const uint8_t> owned_data_;
+  std::unique_ptr<base::OS::MemoryMappedFile> mapped_file_;
+  base::Vector<const uint8_t> data_;
+  struct PendingFunction {
+    // The offset into {data_}, or 0 if there is no pending code.
+    size_t offset = 0;
+    size_t size = 0;
+    // The checksum of the code at loading time, only for mapped files.
+    uint32_t checksum = 0;
+  };
+  std::vector<PendingFunction> pending_functions_;
+  size_t num_remaining_functions_ = 0;
+};
+
 // Support for deserializing WebAssembly {NativeModule} objects.
 // Checks the version header of the data against the current version.
 bool IsSupportedVersion(base::Vector<const uint8_t> data,
@@ -63,6 +126,19 @@ V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     base::Vector<const uint8_t> wire_bytes, CompileTimeImports compile_imports,
     base::Vector<const char> source_url);
 
+// Deserializes the data in the given file to create a Wasm module object. With
+// --wasm-lazy-deserialization, the file stays mapped read-only instead of
+// being copied, so processes that load the same file share its pages. The
+// code of each function is copied out of the mapping and checked against its
+// checksum at loading time before it is deserialized, so the file may be
+// appended to (see {WasmSerializer::SerializeAppendedCode}) or replaced by
+// renaming another file over it while it is mapped. It must not be truncated
+// or rewritten in place though, since accessing the truncated part of a
+// mapping raises SIGBUS.
+V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> DeserializeNativeModuleFromFile(
+    Isolate*, const char* filename, base::Vector<const uint8_t> wire_bytes,
+    CompileTimeImports compile_imports, base::Vector<const char> source_url);
+
 }  // namespace v8::internal::wasm
 
 #endif  // V8_WASM_WASM_SERIALIZATION_H_
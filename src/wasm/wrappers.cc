@@ -8,6 +8,7 @@
 #include "src/compiler/linkage.h"
 #include "src/compiler/turboshaft/index.h"
 #include "src/compiler/turboshaft/wasm-assembler-helpers.h"
+#include "src/objects/bigint.h"
 #include "src/objects/object-list-macros.h"
 #include "src/wasm/turboshaft-graph-interface.h"
 #include "src/wasm/wasm-engine.h"
@@ -37,6 +38,7 @@ using compiler::turboshaft::Tuple;
 using compiler::turboshaft::V;
 using compiler::turboshaft::Variable;
 using compiler::turboshaft::Word32;
+using compiler::turboshaft::Word64;
 using compiler::turboshaft::WordPtr;
 
 namespace {
@@ -836,9 +838,29 @@ class WasmWrapperTSGraphBuilder : public WasmGraphBuilderBase {
         }
         return result;
       }
+      case wasm::kI64: {
+        // Like {BigInt::AsInt64}: the value is the least significant digit,
+        // negated for negative BigInts.
+        DCHECK(Is64());
+        ScopedVar<Word64> result(this, __ Word64Constant(uint64_t{0}));
+        V<Word32> bitfield = __ template LoadField<Word32>(
+            input, compiler::AccessBuilder::ForBigIntBitfield());
+        IF_NOT (__ Word32Equal(bitfield, 0)) {
+          V<Word64> lsd = __ template LoadField<Word64>(
+              input,
+              compiler::AccessBuilder::ForBigIntLeastSignificantDigit64());
+          IF (__ Word32BitwiseAnd(bitfield, BigInt::SignBits::kMask)) {
+            result = __ Word64Sub(0, lsd);
+          } ELSE {
+            result = lsd;
+          }
+        }
+        return result;
+      }
       case wasm::kRef:
       case wasm::kRefNull:
-      case wasm::kI64:
+        // Externrefs are passed on unmodified.
+        return input;
       case wasm::kRtt:
       case wasm::kS128:
       case wasm::kI8:
@@ -1031,7 +1053,15 @@ class WasmWrapperTSGraphBuilder : public WasmGraphBuilderBase {
       switch (type.kind()) {
         case wasm::kRef:
         case wasm::kRefNull:
+          if (type.heap_representation_non_shared() !=
+              wasm::HeapType::kExtern) {
+            return false;
+          }
+          break;
         case wasm::kI64:
+          // The BigInt is only converted inline if its digits are 64 bits.
+          if (!Is64()) return false;
+          break;
         case wasm::kRtt:
         case wasm::kS128:
         case wasm::kI8:
@@ -1090,9 +1120,20 @@ class WasmWrapperTSGraphBuilder : public WasmGraphBuilderBase {
         __ Bind(done);
         return;
       }
+      case wasm::kI64: {
+        __ GotoIf(UNLIKELY(__ IsSmi(input)), slow_path);
+        V<Map> map = LoadMap(input);
+        __ GotoIfNot(LIKELY(__ TaggedEqual(map, LOAD_ROOT(BigIntMap))),
+                     slow_path);
+        return;
+      }
       case wasm::kRef:
+        // The slow path throws the TypeError for null.
+        __ GotoIf(UNLIKELY(__ TaggedEqual(input, LOAD_ROOT(NullValue))),
+                  slow_path);
+        return;
       case wasm::kRefNull:
-      case wasm::kI64:
+        return;
       case wasm::kRtt:
       case wasm::kS128:
       case wasm::kI8:
@@ -0,0 +1,114 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/codegen/cpu-features.h"
+#include "src/objects/string.h"
+#include "src/strings/string-case.h"
+#include "src/strings/string-simd.h"
+#include "src/strings/unicode-decoder.h"
+#include "src/utils/utils.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+using v8::internal::CompareCharsEqualWithSimd;
+using v8::internal::CpuFeatures;
+using v8::internal::FastAsciiConvert;
+using v8::internal::NonAsciiStart;
+using v8::internal::StringSimd;
+
+// Each benchmark runs the callers of the kernels, so that kNone measures their
+// scalar loops, i.e. the code that runs without the kernels.
+static bool SetKind(benchmark::State& state, StringSimd::Kind kind) {
+  static bool initialized = false;
+  if (!initialized) {
+    CpuFeatures::Probe(false);
+    initialized = true;
+  }
+  if (!StringSimd::IsSupported(kind)) {
+    state.SkipWithError("not supported on this CPU");
+    return false;
+  }
+  StringSimd::SetKindForTesting(kind);
+  return true;
+}
+
+static std::vector<uint8_t> AsciiText(size_t length) {
+  static const char kText[] = "The quick brown fox jumps over the lazy dog. ";
+  std::vector<uint8_t> chars(length);
+  for (size_t i = 0; i < length; ++i) {
+    chars[i] = kText[i % (sizeof(kText) - 1)];
+  }
+  return chars;
+}
+
+static void BM_NonAsciiStart(benchmark::State& state, StringSimd::Kind kind) {
+  if (!SetKind(state, kind)) return;
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> chars = AsciiText(length);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NonAsciiStart(chars.data(), length));
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+
+static void BM_NonOneByteStart(benchmark::State& state,
+                               StringSimd::Kind kind) {
+  if (!SetKind(state, kind)) return;
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> text = AsciiText(length);
+  std::vector<uint16_t> chars(text.begin(), text.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        v8::internal::String::NonOneByteStart(chars.data(), length));
+  }
+  state.SetBytesProcessed(state.iterations() * length * sizeof(uint16_t));
+}
+
+static void BM_CompareCharsEqual(benchmark::State& state,
+                                 StringSimd::Kind kind) {
+  if (!SetKind(state, kind)) return;
+  const size_t length = state.range(0);
+  std::vector<uint8_t> one_byte = AsciiText(length);
+  std::vector<uint16_t> two_byte(one_byte.begin(), one_byte.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        CompareCharsEqualWithSimd(one_byte.data(), two_byte.data(), length));
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+
+static void BM_FastAsciiConvert(benchmark::State& state,
+                                StringSimd::Kind kind) {
+  if (!SetKind(state, kind)) return;
+  const int length = static_cast<int>(state.range(0));
+  std::vector<uint8_t> src = AsciiText(length);
+  // Strings are word-aligned.
+  std::vector<uintptr_t> dst(length / sizeof(uintptr_t) + 1);
+  for (auto _ : state) {
+    bool changed = false;
+    benchmark::DoNotOptimize(FastAsciiConvert<true>(
+        reinterpret_cast<char*>(dst.data()),
+        reinterpret_cast<const char*>(src.data()), length, &changed));
+    benchmark::DoNotOptimize(changed);
+  }
+  state.SetBytesProcessed(state.iterations() * length);
+}
+
+#define STRING_SIMD_BENCHMARK(name)                                   \
+  BENCHMARK_CAPTURE(name, Scalar, StringSimd::Kind::kNone)            \
+      ->Range(StringSimd::kMinLength, 64 << 10);                      \
+  BENCHMARK_CAPTURE(name, SSE, StringSimd::Kind::kSSE)                \
+      ->Range(StringSimd::kMinLength, 64 << 10);                      \
+  BENCHMARK_CAPTURE(name, AVX2, StringSimd::Kind::kAVX2)              \
+      ->Range(StringSimd::kMinLength, 64 << 10);                      \
+  BENCHMARK_CAPTURE(name, Neon, StringSimd::Kind::kNeon)              \
+      ->Range(StringSimd::kMinLength, 64 << 10);
+
+STRING_SIMD_BENCHMARK(BM_NonAsciiStart)
+STRING_SIMD_BENCHMARK(BM_NonOneByteStart)
+STRING_SIMD_BENCHMARK(BM_CompareCharsEqual)
+STRING_SIMD_BENCHMARK(BM_FastAsciiConvert)
+
+#undef STRING_SIMD_BENCHMARK
@@ -0,0 +1,125 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/v8-isolate.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/execution/isolate.h"
+#include "src/execution/local-isolate-inl.h"
+#include "src/handles/local-handles-inl.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope-inl.h"
+#include "test/benchmarks/cpp/benchmark-utils.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+namespace {
+
+using v8::internal::Handle;
+using v8::internal::Isolate;
+using v8::internal::LocalHandleScope;
+using v8::internal::LocalIsolate;
+using v8::internal::ParkingSemaphore;
+using v8::internal::ParkingThread;
+using v8::internal::String;
+using v8::internal::ThreadKind;
+using v8::internal::UnparkedScope;
+
+// Strings inserted by each thread in one iteration. Enough for the table to be
+// resized while the threads insert.
+constexpr int kStringsPerThread = 20000;
+
+// Internalizes the strings "<prefix><i>" for 0 <= i < kStringsPerThread on a
+// background thread, and measures how long this takes.
+class InternalizerThread final : public ParkingThread {
+ public:
+  InternalizerThread(Isolate* isolate, std::string prefix,
+                     ParkingSemaphore* sema_ready, ParkingSemaphore* sema_start)
+      : ParkingThread(v8::base::Thread::Options("InternalizerThread")),
+        isolate_(isolate),
+        prefix_(std::move(prefix)),
+        sema_ready_(sema_ready),
+        sema_start_(sema_start) {}
+
+  void Run() override {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_isolate);
+
+    sema_ready_->Signal();
+    sema_start_->ParkedWait(&local_isolate);
+
+    v8::base::ElapsedTimer timer;
+    timer.Start();
+    for (int i = 0; i < kStringsPerThread; ++i) {
+      LocalHandleScope handle_scope(&local_isolate);
+      std::string name = prefix_ + std::to_string(i);
+      Handle<String> string = local_isolate.factory()->InternalizeString(
+          v8::base::OneByteVector(name.c_str(), name.length()));
+      benchmark::DoNotOptimize(string);
+    }
+    elapsed_ = timer.Elapsed();
+  }
+
+  v8::base::TimeDelta elapsed() const { return elapsed_; }
+
+ private:
+  Isolate* isolate_;
+  const std::string prefix_;
+  ParkingSemaphore* sema_ready_;
+  ParkingSemaphore* sema_start_;
+  v8::base::TimeDelta elapsed_;
+};
+
+class StringTableBenchmark : public v8::benchmarking::BenchmarkWithIsolate {};
+
+}  // namespace
+
+// Measures the throughput of concurrent insertions of distinct strings into
+// the string table. Each iteration uses new strings, so that all of them are
+// inserted, and takes the time of the slowest thread.
+BENCHMARK_DEFINE_F(StringTableBenchmark, ConcurrentInsertions)
+(benchmark::State& state) {
+  const int thread_count = static_cast<int>(state.range(0));
+  Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate());
+  LocalIsolate* main_local_isolate = isolate->main_thread_local_isolate();
+  int round = 0;
+  for (auto _ : state) {
+    ParkingSemaphore sema_ready(0);
+    ParkingSemaphore sema_start(0);
+    std::vector<std::unique_ptr<InternalizerThread>> threads;
+    for (int t = 0; t < thread_count; ++t) {
+      std::string prefix = "insertion-" + std::to_string(round) + "-" +
+                           std::to_string(t) + "-";
+      auto thread = std::make_unique<InternalizerThread>(
+          isolate, std::move(prefix), &sema_ready, &sema_start);
+      CHECK(thread->Start());
+      threads.push_back(std::move(thread));
+    }
+    for (int t = 0; t < thread_count; ++t) {
+      sema_ready.ParkedWait(main_local_isolate);
+    }
+    for (int t = 0; t < thread_count; ++t) sema_start.Signal();
+    ParkingThread::ParkedJoinAll(main_local_isolate, threads);
+
+    v8::base::TimeDelta slowest;
+    for (const auto& thread : threads) {
+      slowest = std::max(slowest, thread->elapsed());
+    }
+    state.SetIterationTime(slowest.InSecondsF());
+    ++round;
+  }
+  state.SetItemsProcessed(state.iterations() * thread_count *
+                          kStringsPerThread);
+}
+
+BENCHMARK_REGISTER_F(StringTableBenchmark, ConcurrentInsertions)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
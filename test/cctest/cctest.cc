@@ -40,6 +40,7 @@
 #include "src/base/optional.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/base/platform/semaphore.h"
 #include "src/base/strings.h"
 #include "src/codegen/compiler.h"
@@ -288,6 +289,27 @@ HandleAndZoneScope::HandleAndZoneScope(bool support_zone_compression)
 
 HandleAndZoneScope::~HandleAndZoneScope() = default;
 
+TemporaryFileScope::TemporaryFileScope(const char* name) {
+#if V8_OS_WIN
+  const char* directory = getenv("TEMP");
+#else
+  const char* directory = getenv("TMPDIR");
+#endif
+  if (directory == nullptr || *directory == '\0') {
+#if V8_OS_WIN
+    directory = ".";
+#else
+    directory = "/tmp";
+#endif
+  }
+  path_ = std::string(directory) + v8::base::OS::DirectorySeparator() +
+          std::to_string(v8::base::OS::GetCurrentProcessId()) + "-" + name;
+}
+
+TemporaryFileScope::~TemporaryFileScope() {
+  v8::base::OS::Remove(path_.c_str());
+}
+
 #ifdef V8_ENABLE_TURBOFAN
 i::Handle<i::JSFunction> Optimize(i::Handle<i::JSFunction> function,
                                   i::Zone* zone, i::Isolate* isolate,
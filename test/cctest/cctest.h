@@ -29,6 +29,7 @@
 #define CCTEST_H_
 
 #include <memory>
+#include <string>
 
 #include "include/libplatform/libplatform.h"
 #include "include/v8-platform.h"
@@ -671,6 +672,22 @@ class V8_NODISCARD HandleAndZoneScope : public InitializedHandleScope {
   std::unique_ptr<i::Zone> main_zone_;
 };
 
+// The path of a file in the temporary directory whose name is unique to the
+// process, so variants of a test that run in parallel do not share the file.
+// The file is removed when the scope ends, if it exists.
+class V8_NODISCARD TemporaryFileScope {
+ public:
+  explicit TemporaryFileScope(const char* name);
+  ~TemporaryFileScope();
+  TemporaryFileScope(const TemporaryFileScope&) = delete;
+  TemporaryFileScope& operator=(const TemporaryFileScope&) = delete;
+
+  const char* path() const { return path_.c_str(); }
+
+ private:
+  std::string path_;
+};
+
 class StaticOneByteResource : public v8::String::ExternalOneByteStringResource {
  public:
   explicit StaticOneByteResource(const char* data) : data_(data) {}
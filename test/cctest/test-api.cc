@@ -9033,6 +9033,37 @@ THREADED_TEST(Utf16Trailing3Byte) {
   delete[] buffer;
 }
 
+THREADED_TEST(Utf8RoundTripWithAsciiRuns) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // Runs of ASCII characters of various lengths, which are decoded and encoded
+  // in bulk, between one-byte, two-byte and surrogate pair characters.
+  const char* kPieces[] = {"\xC3\xA9", "\xE2\x80\xA6", "\xF0\x9F\x98\x8D"};
+  for (const char* piece : kPieces) {
+    std::string utf8;
+    for (int run = 0; run < 100; run++) {
+      utf8.append(run, 'a' + run % 26);
+      utf8.append(piece);
+    }
+    v8::Local<v8::String> str =
+        v8::String::NewFromUtf8(isolate, utf8.data(),
+                                v8::NewStringType::kNormal,
+                                static_cast<int>(utf8.size()))
+            .ToLocalChecked();
+    CHECK_EQ(static_cast<int>(utf8.size()), str->Utf8Length(isolate));
+
+    std::vector<char> buffer(utf8.size() + 1);
+    int nchars;
+    int written = str->WriteUtf8(isolate, buffer.data(),
+                                 static_cast<int>(buffer.size()), &nchars);
+    CHECK_EQ(static_cast<int>(buffer.size()), written);
+    CHECK_EQ(str->Length(), nchars);
+    CHECK_EQ(0, memcmp(utf8.data(), buffer.data(), utf8.size()));
+    CHECK_EQ('\0', buffer[utf8.size()]);
+  }
+}
 
 THREADED_TEST(ToArrayIndex) {
   LocalContext context;
@@ -23991,6 +24022,98 @@ TEST(CodeCache) {
   isolate2->Dispose();
 }
 
+namespace {
+
+void WriteTestFile(const char* path, const char* contents) {
+  FILE* file = v8::base::OS::FOpen(path, "wb");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(strlen(contents), fwrite(contents, 1, strlen(contents), file));
+  fclose(file);
+}
+
+}  // namespace
+
+TEST(CodeCacheWithMappedFileSource) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  TemporaryFileScope file("test-api-mapped-file-source.js");
+  const char* path = file.path();
+  const char* source = "Math.sqrt(4)";
+  WriteTestFile(path, source);
+  const char* origin = "mapped file code cache test";
+  v8::ScriptCompiler::CachedData* cache;
+
+  // The mappings are released when the isolates are torn down.
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope cscope(context);
+    v8::Local<v8::String> source_string =
+        v8::String::NewExternalOneByteFromFile(isolate1, path)
+            .ToLocalChecked();
+    CHECK(source_string->IsExternalOneByte());
+    CHECK(v8_str(source)->StrictEquals(source_string));
+    v8::ScriptOrigin script_origin(v8_str(origin));
+    v8::ScriptCompiler::Source script_source(source_string, script_origin);
+    v8::Local<v8::Script> script =
+        v8::ScriptCompiler::Compile(context, &script_source).ToLocalChecked();
+    cache = v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript());
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope cscope(context);
+    v8::Local<v8::String> source_string =
+        v8::String::NewExternalOneByteFromFile(isolate2, path)
+            .ToLocalChecked();
+    v8::ScriptOrigin script_origin(v8_str(origin));
+    v8::ScriptCompiler::Source script_source(source_string, script_origin,
+                                             cache);
+    v8::Local<v8::Script> script;
+    {
+      i::DisallowCompilation no_compile(
+          reinterpret_cast<i::Isolate*>(isolate2));
+      v8::ScriptCompiler::CompileOptions option =
+          v8::ScriptCompiler::kConsumeCodeCache;
+      script = v8::ScriptCompiler::Compile(context, &script_source, option)
+                   .ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+    CHECK_EQ(2, script->Run(context)
+                    .ToLocalChecked()
+                    ->Int32Value(context)
+                    .FromJust());
+  }
+  isolate2->Dispose();
+}
+
+TEST(NewExternalOneByteFromFileFailures) {
+  TemporaryFileScope file("test-api-mapped-file-non-ascii.js");
+  const char* path = file.path();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  // The file does not exist yet.
+  CHECK(v8::String::NewExternalOneByteFromFile(isolate, path).IsEmpty());
+
+  // Non-ASCII files would need to be decoded.
+  WriteTestFile(path, "'\xC3\xA9'");
+  CHECK(v8::String::NewExternalOneByteFromFile(isolate, path).IsEmpty());
+
+  WriteTestFile(path, "");
+  CHECK_EQ(0, v8::String::NewExternalOneByteFromFile(isolate, path)
+                  .ToLocalChecked()
+                  ->Length());
+}
+
 v8::MaybeLocal<Value> UnexpectedSyntheticModuleEvaluationStepsCallback(
     Local<Context> context, Local<Module> module) {
   CHECK_WITH_MSG(false, "Unexpected call to synthetic module re callback");
@@ -874,6 +874,74 @@ TEST(DeepOneByte) {
   DeleteArray<char>(foo);
 }
 
+TEST(CompareConsStrings) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Ropes as deep as repeated appends build them, which differ from each other
+  // only close to their ends.
+  const int kDepth = 20000;
+  Handle<String> block = factory->NewStringFromStaticChars("0123456789abcd");
+  const base::uc16 kTwoByteChars[] = {'0', '1', '2', '3', '4', '5', '6',
+                                      '7', '8', '9', 'a', 'b', 'c', 'd'};
+  Handle<String> two_byte_block =
+      factory->NewStringFromTwoByte(base::ArrayVector(kTwoByteChars))
+          .ToHandleChecked();
+  Handle<String> rope = factory->empty_string();
+  Handle<String> two_byte_rope = factory->empty_string();
+  for (int i = 0; i < kDepth; i++) {
+    rope = factory->NewConsString(rope, block).ToHandleChecked();
+    two_byte_rope =
+        factory->NewConsString(two_byte_rope, two_byte_block).ToHandleChecked();
+  }
+  Handle<String> smaller =
+      factory->NewConsString(rope, factory->NewStringFromStaticChars("0"))
+          .ToHandleChecked();
+  Handle<String> larger =
+      factory
+          ->NewConsString(two_byte_rope, factory->NewStringFromStaticChars("1"))
+          .ToHandleChecked();
+  Handle<String> flat_rope =
+      factory->NewConsString(rope, block).ToHandleChecked();
+  String::Flatten(isolate, flat_rope);
+
+  CHECK_EQ(ComparisonResult::kEqual,
+           String::Compare(isolate, rope, two_byte_rope));
+  CHECK_EQ(ComparisonResult::kLessThan,
+           String::Compare(isolate, rope, smaller));
+  CHECK_EQ(ComparisonResult::kGreaterThan,
+           String::Compare(isolate, smaller, rope));
+  CHECK_EQ(ComparisonResult::kLessThan,
+           String::Compare(isolate, smaller, larger));
+  CHECK_EQ(ComparisonResult::kGreaterThan,
+           String::Compare(isolate, larger, smaller));
+  CHECK_EQ(ComparisonResult::kLessThan,
+           String::Compare(isolate, rope, flat_rope));
+  CHECK_EQ(ComparisonResult::kGreaterThan,
+           String::Compare(isolate, flat_rope, smaller));
+
+  // Deep ropes are flattened, so that comparing them again is cheap.
+  CHECK(rope->IsFlat());
+  CHECK(two_byte_rope->IsFlat());
+
+  // Shallow ropes are compared without flattening them.
+  Handle<String> shallow =
+      factory->NewConsString(block, block).ToHandleChecked();
+  Handle<String> shallow_larger =
+      factory
+          ->NewConsString(two_byte_block,
+                          factory->NewStringFromStaticChars("0123456789abce"))
+          .ToHandleChecked();
+  CHECK_EQ(ComparisonResult::kLessThan,
+           String::Compare(isolate, shallow, shallow_larger));
+  CHECK_EQ(ComparisonResult::kGreaterThan,
+           String::Compare(isolate, shallow_larger, shallow));
+  CHECK(!shallow->IsFlat());
+  CHECK(!shallow_larger->IsFlat());
+}
+
 TEST(Utf8Conversion) {
   // Smoke test for converting strings to utf-8.
   CcTest::InitializeVM();
@@ -755,6 +755,59 @@ STREAM_TEST(TestErrorInCodeSectionDetectedByCompiler) {
   CHECK(tester.IsPromiseRejected());
 }
 
+// Test an error in a lazily compiled function, found by background validation
+// while the rest of the code section is still streaming in.
+STREAM_TEST(TestErrorInLazyFunctionDetectedByBackgroundValidation) {
+  FlagScope<bool> lazy_compilation(&v8_flags.wasm_lazy_compilation, true);
+  FlagScope<bool> no_lazy_validation(&v8_flags.wasm_lazy_validation, false);
+  StreamTester tester(isolate);
+
+  uint8_t code[] = {
+      U32V_1(4),                  // body size
+      U32V_1(0),                  // locals count
+      kExprLocalGet, 0, kExprEnd  // body
+  };
+
+  uint8_t invalid_code[] = {
+      U32V_1(4),                  // body size
+      U32V_1(0),                  // locals count
+      kExprI64Const, 0, kExprEnd  // body
+  };
+
+  const uint8_t bytes[] = {
+      WASM_MODULE_HEADER,                 // module header
+      kTypeSectionCode,                   // section code
+      U32V_1(1 + SIZEOF_SIG_ENTRY_x_x),   // section size
+      U32V_1(1),                          // type count
+      SIG_ENTRY_x_x(kI32Code, kI32Code),  // signature entry
+      kFunctionSectionCode,               // section code
+      U32V_1(1 + 4),                      // section size
+      U32V_1(4),                          // functions count
+      0,                                  // signature index
+      0,                                  // signature index
+      0,                                  // signature index
+      0,                                  // signature index
+      kCodeSectionCode,                   // section code
+      U32V_1(1 + arraysize(code) * 3 +
+             arraysize(invalid_code)),  // section size
+      U32V_1(4),                        // functions count
+  };
+
+  tester.OnBytesReceived(bytes, arraysize(bytes));
+  tester.OnBytesReceived(code, arraysize(code));
+  tester.OnBytesReceived(invalid_code, arraysize(invalid_code));
+  // Background validation of the received bodies runs before the stream ends.
+  tester.RunCompilerTasks();
+  tester.OnBytesReceived(code, arraysize(code));
+  tester.OnBytesReceived(code, arraysize(code));
+  tester.FinishStream();
+  tester.RunCompilerTasks();
+
+  CHECK(tester.IsPromiseRejected());
+  CHECK_NE(std::string::npos,
+           tester.error_message().find("Compiling function #1 failed"));
+}
+
 // Test Abort before any bytes arrive.
 STREAM_TEST(TestAbortImmediately) {
   StreamTester tester(isolate);
@@ -10,7 +10,9 @@
 #include "src/objects/objects-inl.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/utils/version.h"
+#include "src/wasm/module-compiler.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/pgo.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
@@ -111,6 +113,9 @@ class WasmSerializationTest {
   }
 
   v8::MemorySpan<const uint8_t> wire_bytes() const { return wire_bytes_; }
+  v8::MemorySpan<const uint8_t> serialized_bytes() const {
+    return serialized_bytes_;
+  }
   CompileTimeImports compile_imports() { return compile_imports_; }
 
  private:
@@ -469,4 +474,321 @@ TEST(SerializationFailsOnChangedFeatures) {
   }
 }
 
+TEST(SerializeAppendedCode) {
+  WasmSerializationTest test;
+
+  Isolate* isolate = CcTest::i_isolate();
+  base::Vector<const uint8_t> serialized =
+      base::VectorOf(test.serialized_bytes());
+  std::vector<uint8_t> updated;
+  {
+    HandleScope scope(isolate);
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+
+    // Only the exported function was tiered up before serializing, so there
+    // is nothing to append yet.
+    {
+      WasmSerializer wasm_serializer(native_module);
+      std::vector<uint8_t> buffer(
+          wasm_serializer.GetAppendedCodeSize(serialized));
+      CHECK(!wasm_serializer.SerializeAppendedCode(serialized,
+                                                   base::VectorOf(buffer)));
+    }
+
+    ErrorThrower thrower(isolate, "");
+    Handle<WasmInstanceObject> instance =
+        GetWasmEngine()
+            ->SyncInstantiate(isolate, &thrower, module_object, {}, {})
+            .ToHandleChecked();
+    TierUpAllForTesting(isolate, instance->trusted_data(isolate));
+
+    WasmSerializer wasm_serializer(native_module);
+    size_t appended_size = wasm_serializer.GetAppendedCodeSize(serialized);
+    CHECK_LT(0, appended_size);
+    updated.assign(serialized.begin(), serialized.end());
+    updated.resize(serialized.size() + appended_size);
+    CHECK(wasm_serializer.SerializeAppendedCode(
+        serialized, base::VectorOf(updated).SubVectorFrom(serialized.size())));
+
+    // All functions are contained in the updated data now.
+    std::vector<uint8_t> buffer(
+        wasm_serializer.GetAppendedCodeSize(base::VectorOf(updated)));
+    CHECK(!wasm_serializer.SerializeAppendedCode(base::VectorOf(updated),
+                                                 base::VectorOf(buffer)));
+
+    // Truncated data is rejected.
+    CHECK_EQ(0, wasm_serializer.GetAppendedCodeSize(
+                    base::VectorOf(updated).SubVector(0, 10)));
+  }
+  // Make sure the module gets deserialized and not loaded from the module
+  // cache.
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(
+      isolate->heap());
+  test.CollectGarbage();
+  HandleScope scope(isolate);
+  Handle<WasmModuleObject> module_object;
+  CHECK(DeserializeNativeModule(isolate, base::VectorOf(updated),
+                                base::VectorOf(test.wire_bytes()),
+                                test.compile_imports(), {})
+            .ToHandle(&module_object));
+
+  NativeModule* native_module = module_object->native_module();
+  WasmCodeRefScope code_ref_scope;
+  for (int func_index = 0; func_index < 3; ++func_index) {
+    WasmCode* code = native_module->GetCode(func_index);
+    CHECK_NOT_NULL(code);
+    CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+  }
+}
+
+TEST(DeserializeLazily) {
+  FlagScope<bool> lazy_deserialization(&v8_flags.wasm_lazy_deserialization,
+                                       true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    CHECK_NOT_NULL(native_module->lazy_deserialization_data());
+    {
+      WasmCodeRefScope code_ref_scope;
+      CHECK_NULL(native_module->GetCode(2));
+    }
+
+    // The first call deserializes the TurboFan code.
+    test.DeserializeAndRun();
+    WasmCodeRefScope code_ref_scope;
+    WasmCode* code = native_module->GetCode(2);
+    CHECK_NOT_NULL(code);
+    CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+    CHECK(native_module->lazy_deserialization_data()->empty());
+  }
+  test.CollectGarbage();
+}
+
+TEST(SerializeLazilyDeserializedModule) {
+  FlagScope<bool> lazy_deserialization(&v8_flags.wasm_lazy_deserialization,
+                                       true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    CHECK(!native_module->lazy_deserialization_data()->empty());
+
+    // The pending code is deserialized before serializing again, so it is not
+    // dropped from the new serialization.
+    WasmSerializer wasm_serializer(native_module);
+    CHECK(native_module->lazy_deserialization_data()->empty());
+    std::vector<uint8_t> buffer(
+        wasm_serializer.GetSerializedNativeModuleSize());
+    CHECK(wasm_serializer.SerializeNativeModule(base::VectorOf(buffer)));
+    CHECK_EQ(test.serialized_bytes().size(), buffer.size());
+    WasmCodeRefScope code_ref_scope;
+    WasmCode* code = native_module->GetCode(2);
+    CHECK_NOT_NULL(code);
+    CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+  }
+  test.CollectGarbage();
+}
+
+TEST(DeserializeTruncatedData) {
+  WasmSerializationTest test;
+  base::Vector<const uint8_t> serialized =
+      base::VectorOf(test.serialized_bytes());
+  // Dropping the tiering budget completely is allowed, see
+  // {DeserializeTieringBudgetPartlyMissing} for dropping part of it.
+  size_t tiering_budget_size = 3 * sizeof(uint32_t);
+  for (bool lazy : {false, true}) {
+    FlagScope<bool> lazy_deserialization(&v8_flags.wasm_lazy_deserialization,
+                                         lazy);
+    HandleScope scope(CcTest::i_isolate());
+    // Truncations within the header or the code of a function are rejected
+    // instead of reading out of bounds.
+    for (size_t size = 0; size < serialized.size() - tiering_budget_size;
+         ++size) {
+      CHECK(DeserializeNativeModule(
+                CcTest::i_isolate(), serialized.SubVector(0, size),
+                base::VectorOf(test.wire_bytes()), test.compile_imports(), {})
+                .is_null());
+    }
+  }
+  test.CollectGarbage();
+}
+
+TEST(RestoreProfileData) {
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    const WasmModule* module = native_module->module();
+    base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+
+    base::OwnedVector<uint8_t> profile_data = GetProfileData(
+        module, wire_bytes, native_module->tiering_budget_array());
+    std::unique_ptr<ProfileInformation> pgo_info =
+        RestoreProfileData(module, wire_bytes, profile_data.as_vector());
+    CHECK_NOT_NULL(pgo_info);
+    // Only the exported function was executed.
+    CHECK_EQ(1, pgo_info->executed_functions().size());
+    CHECK_EQ(2, pgo_info->executed_functions()[0]);
+
+    // Profiles of other wire bytes and truncated profiles are ignored.
+    std::vector<uint8_t> other_wire_bytes(wire_bytes.begin(), wire_bytes.end());
+    other_wire_bytes.back() ^= 1;
+    CHECK_NULL(RestoreProfileData(module, base::VectorOf(other_wire_bytes),
+                                  profile_data.as_vector()));
+    CHECK_NULL(RestoreProfileData(
+        module, wire_bytes,
+        profile_data.as_vector().SubVector(0, profile_data.size() - 1)));
+  }
+  test.CollectGarbage();
+}
+
+TEST(RestoreCorruptedProfileData) {
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    const WasmModule* module = native_module->module();
+    base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+
+    // Reuse the magic number, format version and wire bytes hash of a valid
+    // profile.
+    base::OwnedVector<uint8_t> valid_profile = GetProfileData(
+        module, wire_bytes, native_module->tiering_budget_array());
+    base::Vector<const uint8_t> header =
+        valid_profile.as_vector().SubVector(0, 3 * sizeof(uint32_t));
+
+    // Builds a profile with feedback for a single call site in function 2,
+    // given as pairs of function index and call count.
+    AccountingAllocator allocator;
+    Zone zone(&allocator, ZONE_NAME);
+    auto make_profile = [&](std::initializer_list<int> cases,
+                            uint32_t call_target) {
+      ZoneBuffer buffer(&zone);
+      buffer.write(header.begin(), header.size());
+      buffer.write_u32v(1);  // number of function entries
+      buffer.write_u32v(2);  // function index
+      buffer.write_u32v(1);  // feedback vector size
+      buffer.write_i32v(static_cast<int>(cases.size() / 2));
+      for (int value : cases) buffer.write_i32v(value);
+      buffer.write_u32v(1);  // number of call targets
+      buffer.write_u32v(call_target);
+      for (int i = 0; i < 3; ++i) buffer.write_u8(0);  // tiering info
+      return base::OwnedVector<uint8_t>::Of(buffer);
+    };
+    auto restore = [&](base::OwnedVector<uint8_t> profile) {
+      return RestoreProfileData(module, wire_bytes, profile.as_vector());
+    };
+
+    CHECK_NOT_NULL(restore(make_profile({0, 5}, 0)));
+    CHECK_NOT_NULL(restore(make_profile({0, 5, 1, 3}, 1)));
+    CHECK_NOT_NULL(
+        restore(make_profile({0, 5}, FunctionTypeFeedback::kCallRef)));
+
+    // Function indexes out of range and negative call counts are rejected
+    // for monomorphic and polymorphic call sites.
+    CHECK_NULL(restore(make_profile({-5, 1}, 0)));
+    CHECK_NULL(restore(make_profile({3, 1}, 0)));
+    CHECK_NULL(restore(make_profile({0, -1}, 0)));
+    CHECK_NULL(restore(make_profile({0, 5, -2, 3}, 0)));
+    CHECK_NULL(restore(make_profile({0, 5, 3, 3}, 0)));
+    CHECK_NULL(restore(make_profile({0, 5, 1, -3}, 0)));
+    // So are call targets that are neither functions nor sentinels.
+    CHECK_NULL(restore(make_profile({0, 5}, 3)));
+    CHECK_NULL(restore(
+        make_profile({0, 5}, FunctionTypeFeedback::kCallIndirect - 1)));
+  }
+  test.CollectGarbage();
+}
+
+namespace {
+void WriteSerializedFile(const char* path,
+                         base::Vector<const uint8_t> serialized) {
+  std::unique_ptr<base::OS::MemoryMappedFile> file{
+      base::OS::MemoryMappedFile::create(
+          path, serialized.size(), const_cast<uint8_t*>(serialized.begin()))};
+  CHECK_NOT_NULL(file);
+}
+
+NativeModule* DeserializeFromFile(const char* path,
+                                  v8::MemorySpan<const uint8_t> wire_bytes) {
+  v8::Local<v8::WasmModuleObject> module_object;
+  if (!v8::WasmModuleObject::DeserializeFromFile(CcTest::isolate(), path,
+                                                 wire_bytes)
+           .ToLocal(&module_object)) {
+    return nullptr;
+  }
+  return DirectHandle<WasmModuleObject>::cast(
+             v8::Utils::OpenDirectHandle(*module_object))
+      ->native_module();
+}
+}  // namespace
+
+TEST(DeserializeLazilyFromFile) {
+  FlagScope<bool> lazy_deserialization(&v8_flags.wasm_lazy_deserialization,
+                                       true);
+  WasmSerializationTest test;
+  TemporaryFileScope file("wasm-serialization-test.bin");
+  WriteSerializedFile(file.path(), base::VectorOf(test.serialized_bytes()));
+  {
+    HandleScope scope(CcTest::i_isolate());
+    NativeModule* native_module =
+        DeserializeFromFile(file.path(), test.wire_bytes());
+    CHECK_NOT_NULL(native_module);
+    CHECK_NOT_NULL(native_module->lazy_deserialization_data());
+    // The code is deserialized from the mapped file on the first call.
+    test.DeserializeAndRun();
+    CHECK(native_module->lazy_deserialization_data()->empty());
+    WasmCodeRefScope code_ref_scope;
+    CHECK_EQ(ExecutionTier::kTurbofan, native_module->GetCode(2)->tier());
+  }
+  CHECK(base::OS::Remove(file.path()));
+  CHECK_NULL(DeserializeFromFile(file.path(), test.wire_bytes()));
+  test.CollectGarbage();
+}
+
+TEST(DeserializeLazilyFromChangedFile) {
+  FlagScope<bool> lazy_deserialization(&v8_flags.wasm_lazy_deserialization,
+                                       true);
+  WasmSerializationTest test;
+  TemporaryFileScope file("wasm-serialization-test.bin");
+  base::Vector<const uint8_t> serialized =
+      base::VectorOf(test.serialized_bytes());
+  WriteSerializedFile(file.path(), serialized);
+  {
+    HandleScope scope(CcTest::i_isolate());
+    NativeModule* native_module =
+        DeserializeFromFile(file.path(), test.wire_bytes());
+    CHECK_NOT_NULL(native_module);
+    CHECK_NOT_NULL(native_module->lazy_deserialization_data());
+
+    // Rewrite the code in the file while it is mapped. Whether the mapping
+    // sees the change depends on the platform, but the changed code must
+    // never be used.
+    {
+      std::unique_ptr<base::OS::MemoryMappedFile> mapped_file{
+          base::OS::MemoryMappedFile::open(file.path())};
+      CHECK_NOT_NULL(mapped_file);
+      CHECK_EQ(serialized.size(), mapped_file->size());
+      uint8_t* bytes = reinterpret_cast<uint8_t*>(mapped_file->memory());
+      for (size_t i = serialized.size() / 2; i < serialized.size(); ++i) {
+        bytes[i] ^= 0xff;
+      }
+    }
+    test.DeserializeAndRun();
+    CHECK(native_module->lazy_deserialization_data()->empty());
+  }
+  test.CollectGarbage();
+}
+
 }  // namespace v8::internal::wasm
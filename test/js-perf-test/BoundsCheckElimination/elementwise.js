@@ -0,0 +1,75 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Element-wise loops whose index is bounded by the length of the array that
+// they access. The bounds checks of these accesses are redundant with the loop
+// condition, and can be removed by the optimizing compiler (compare with
+// --no-turboshaft-loop-bounds-check-elimination).
+
+new BenchmarkSuite('ArraySum', [1000], [
+  new Benchmark('ArraySum', false, false, 0, ArraySum),
+]);
+
+new BenchmarkSuite('ArrayCopy', [1000], [
+  new Benchmark('ArrayCopy', false, false, 0, ArrayCopy),
+]);
+
+new BenchmarkSuite('TypedArrayScale', [1000], [
+  new Benchmark('TypedArrayScale', false, false, 0, TypedArrayScale),
+]);
+
+new BenchmarkSuite('TypedArrayDot', [1000], [
+  new Benchmark('TypedArrayDot', false, false, 0, TypedArrayDot),
+]);
+
+const kLength = 10000;
+
+const smis = [];
+const smis_copy = [];
+for (let i = 0; i < kLength; i++) {
+  smis.push(i & 0xff);
+  smis_copy.push(0);
+}
+
+const floats = new Float64Array(kLength);
+const floats2 = new Float64Array(kLength);
+for (let i = 0; i < kLength; i++) {
+  floats[i] = i / 7;
+  floats2[i] = i / 3;
+}
+
+function ArraySum() {
+  let sum = 0;
+  for (let i = 0; i < smis.length; i++) {
+    sum += smis[i];
+  }
+  return sum;
+}
+
+function ArrayCopy() {
+  const src = smis;
+  const dst = smis_copy;
+  for (let i = 0; i < dst.length; i++) {
+    dst[i] = src[i];
+  }
+  return dst;
+}
+
+function TypedArrayScale() {
+  const a = floats;
+  for (let i = 0; i < a.length; i++) {
+    a[i] = a[i] * 1.0001;
+  }
+  return a;
+}
+
+function TypedArrayDot() {
+  const a = floats;
+  const b = floats2;
+  let result = 0;
+  for (let i = 0; i < a.length; i++) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
@@ -0,0 +1,95 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Liftoff code quality of loops that keep their state in locals, and the
+// Liftoff compile time of a module with many such loops. Run with and without
+// --liftoff-cache-loop-locals to compare the two.
+
+new BenchmarkSuite('LoopExecution', [1000], [
+  new Benchmark('LoopExecution', false, false, 0, LoopExecution,
+                LoopExecutionSetup),
+]);
+
+new BenchmarkSuite('LoopCompilation', [1000], [
+  new Benchmark('LoopCompilation', false, false, 0, LoopCompilation),
+]);
+
+const kNumCompiledFunctions = 500;
+const kNumIterations = 10000;
+
+function U32(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value) byte |= 0x80;
+    bytes.push(byte);
+  } while (value);
+  return bytes;
+}
+
+function Section(id, contents) {
+  return [id, ...U32(contents.length), ...contents];
+}
+
+function Vec(elements) {
+  return [...U32(elements.length), ...elements.flat()];
+}
+
+// (func (param $n i32) (result i32) (local $i i32) (local $sum i32)
+//   (loop
+//     (local.set $sum (i32.add (local.get $sum)
+//       (i32.mul (i32.load (i32.shl (local.get $i) (i32.const 2)))
+//                (local.get $i))))
+//     (br_if 0 (i32.lt_u (local.tee $i (i32.add (local.get $i) (i32.const 1)))
+//                        (local.get $n))))
+//   (local.get $sum))
+const kLoopFunctionBody = [
+  1, 2, 0x7f,                   // locals: 2 x i32
+  0x03, 0x40,                   // loop
+  0x20, 2,                      //   local.get $sum
+  0x20, 1, 0x41, 2, 0x74,       //   local.get $i, i32.const 2, i32.shl
+  0x28, 2, 0,                   //   i32.load
+  0x20, 1, 0x6c,                //   local.get $i, i32.mul
+  0x6a, 0x21, 2,                //   i32.add, local.set $sum
+  0x20, 1, 0x41, 1, 0x6a,       //   local.get $i, i32.const 1, i32.add
+  0x22, 1, 0x20, 0, 0x49,       //   local.tee $i, local.get $n, i32.lt_u
+  0x0d, 0,                      //   br_if 0
+  0x0b,                         // end
+  0x20, 2,                      // local.get $sum
+  0x0b                          // end
+];
+
+function LoopModuleBytes(num_functions) {
+  const bytes = [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00];
+  // Type section: (i32) -> i32.
+  bytes.push(...Section(1, Vec([[0x60, 1, 0x7f, 1, 0x7f]])));
+  // Function section.
+  bytes.push(...Section(3, Vec(new Array(num_functions).fill([0]))));
+  // Memory section: one page.
+  bytes.push(...Section(5, Vec([[0x00, 1]])));
+  // Export section: function 0 as "main".
+  bytes.push(...Section(7, Vec([[4, 0x6d, 0x61, 0x69, 0x6e, 0x00, 0]])));
+  // Code section.
+  const body = [...U32(kLoopFunctionBody.length), ...kLoopFunctionBody];
+  bytes.push(...Section(10, Vec(new Array(num_functions).fill(body))));
+  return new Uint8Array(bytes);
+}
+
+const compile_bytes = LoopModuleBytes(kNumCompiledFunctions);
+let main;
+
+function LoopExecutionSetup() {
+  const module = new WebAssembly.Module(LoopModuleBytes(1));
+  const instance = new WebAssembly.Instance(module);
+  main = instance.exports.main;
+}
+
+function LoopExecution() {
+  return main(kNumIterations);
+}
+
+function LoopCompilation() {
+  return new WebAssembly.Module(compile_bytes);
+}
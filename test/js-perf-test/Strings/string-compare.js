@@ -0,0 +1,61 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('StringCompareDeepRopes', [1000], [
+  new Benchmark('StringCompareDeepRopes', false, false, 0,
+                CompareDeepRopes, SetupDeepRopes),
+]);
+
+new BenchmarkSuite('StringSortDeepRopes', [1000], [
+  new Benchmark('StringSortDeepRopes', false, false, 0,
+                SortDeepRopes, SetupDeepRopes),
+]);
+
+new BenchmarkSuite('StringCompareShallowRopes', [1000], [
+  new Benchmark('StringCompareShallowRopes', false, false, 0,
+                CompareShallowRopes),
+]);
+
+// Ropes as repeated appends build them, which only differ at their ends.
+var ropes;
+
+function BuildRope(suffix) {
+  var rope = '';
+  for (var i = 0; i < 1000; ++i) {
+    rope += 'abcdefghijklmnop';
+  }
+  return rope + suffix;
+}
+
+function SetupDeepRopes() {
+  ropes = [];
+  for (var i = 0; i < 20; ++i) {
+    ropes.push(BuildRope(String.fromCharCode(0x61 + (i * 7) % 20)));
+  }
+}
+
+function CompareDeepRopes() {
+  var count = 0;
+  for (var i = 0; i < ropes.length; ++i) {
+    for (var j = 0; j < ropes.length; ++j) {
+      if (ropes[i] < ropes[j]) ++count;
+    }
+  }
+  return count;
+}
+
+function SortDeepRopes() {
+  return ropes.slice().sort();
+}
+
+function CompareShallowRopes() {
+  var count = 0;
+  for (var i = 0; i < 100; ++i) {
+    // Fresh ropes of two segments each, which are compared without flattening.
+    var a = 'abcdefghijklmnop' + i;
+    var b = 'abcdefghijklmnop' + (i + 1);
+    if (a < b) ++count;
+  }
+  return count;
+}
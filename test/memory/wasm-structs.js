@@ -0,0 +1,111 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how many bytes Wasm GC structs take up, for struct types whose size
+// depends on how the fields are packed around their alignment gaps. The
+// numbers include the slot that references each struct from an array.
+
+/**
+ * Note: The wasm module builder is not available for memory benchmarks.
+ * To change the wasm code, switch the use_module_builder flag to true, update
+ * the code and run it using d8. It will print the bytes that then have to be
+ * updated for the !use_module_builder path.
+ */
+let use_module_builder = false;
+if (use_module_builder) {
+  d8.file.execute('../mjsunit/wasm/wasm-module-builder.js');
+}
+
+(async function() {
+  let instance;
+
+  if (use_module_builder) {
+    let builder = new WasmModuleBuilder();
+    // Packed fields with gaps of different sizes in declaration order.
+    let packedStruct = builder.addStruct([
+      makeField(kWasmI8, true), makeField(kWasmI16, true),
+      makeField(kWasmI16, true), makeField(kWasmI32, true),
+      makeField(kWasmI8, true), makeField(kWasmI16, true)
+    ]);
+    // Packed fields mixed with 8-byte and reference fields.
+    let mixedStruct = builder.addStruct([
+      makeField(kWasmI8, true), makeField(kWasmI64, true),
+      makeField(kWasmI16, true), makeField(kWasmAnyRef, true),
+      makeField(kWasmI8, true), makeField(kWasmI32, true)
+    ]);
+    let packedArray = builder.addArray(wasmRefNullType(packedStruct), true);
+    let mixedArray = builder.addArray(wasmRefNullType(mixedStruct), true);
+
+    // Returns an array of the given length, filled with new structs.
+    function addAllocate(name, struct, array) {
+      builder.addFunction(name, makeSig([kWasmI32], [kWasmExternRef]))
+        .addLocals(kWasmI32, 1)  // i
+        .addLocals(wasmRefNullType(array), 1)  // result
+        .addBody([
+          kExprLocalGet, 0,
+          kGCPrefix, kExprArrayNewDefault, array,
+          kExprLocalSet, 2,
+          kExprBlock, kWasmVoid,
+            kExprLoop, kWasmVoid,
+              // if (i >= length) break;
+              kExprLocalGet, 1,
+              kExprLocalGet, 0,
+              kExprI32GeS,
+              kExprBrIf, 1,
+              // result[i] = new struct();
+              kExprLocalGet, 2,
+              kExprLocalGet, 1,
+              kGCPrefix, kExprStructNewDefault, struct,
+              kGCPrefix, kExprArraySet, array,
+              // ++i;
+              kExprLocalGet, 1,
+              kExprI32Const, 1,
+              kExprI32Add,
+              kExprLocalSet, 1,
+              kExprBr, 0,
+            kExprEnd,
+          kExprEnd,
+          kExprLocalGet, 2,
+          kGCPrefix, kExprExternConvertAny,
+        ])
+        .exportFunc();
+    }
+    addAllocate('allocatePacked', packedStruct, packedArray);
+    addAllocate('allocateMixed', mixedStruct, mixedArray);
+
+    print(builder.toBuffer());
+    instance = builder.instantiate({});
+  } else {
+    instance = new WebAssembly.Instance(new WebAssembly.Module(new Uint8Array([
+      0, 97, 115, 109, 1, 0, 0, 0, 1, 42, 5, 95, 6, 120, 1, 119, 1, 119, 1, 127,
+      1, 120, 1, 119, 1, 95, 6, 120, 1, 126, 1, 119, 1, 110, 1, 120, 1, 127, 1,
+      94, 99, 0, 1, 94, 99, 1, 1, 96, 1, 127, 1, 111, 3, 3, 2, 4, 4, 7, 34, 2,
+      14, 97, 108, 108, 111, 99, 97, 116, 101, 80, 97, 99, 107, 101, 100, 0, 0,
+      13, 97, 108, 108, 111, 99, 97, 116, 101, 77, 105, 120, 101, 100, 0, 1, 10,
+      103, 2, 50, 2, 1, 127, 1, 99, 2, 32, 0, 251, 7, 2, 33, 2, 2, 64, 3, 64,
+      32, 1, 32, 0, 78, 13, 1, 32, 2, 32, 1, 251, 1, 0, 251, 14, 2, 32, 1, 65,
+      1, 106, 33, 1, 12, 0, 11, 11, 32, 2, 251, 27, 11, 50, 2, 1, 127, 1, 99, 3,
+      32, 0, 251, 7, 3, 33, 2, 2, 64, 3, 64, 32, 1, 32, 0, 78, 13, 1, 32, 2, 32,
+      1, 251, 1, 1, 251, 14, 3, 32, 1, 65, 1, 106, 33, 1, 12, 0, 11, 11, 32, 2,
+      251, 27, 11
+    ])), {});
+  }
+
+  const kCount = 100_000;
+
+  async function HeapSize() {
+    let result = await performance.measureMemory();
+    return result.total.jsMemoryRange[1];
+  }
+
+  for (let name of ['Packed', 'Mixed']) {
+    let before = await HeapSize();
+    let structs = instance.exports['allocate' + name](kCount);
+    let after = await HeapSize();
+    // Keep the structs alive until the second measurement is done.
+    if (structs === null) throw new Error('allocation failed');
+    print(Math.round((after - before) / kCount) + ' bytes per ' + name +
+          ' struct');
+  }
+})();
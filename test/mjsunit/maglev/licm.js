@@ -0,0 +1,63 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --maglev --maglev-licm --no-maglev-loop-peeling
+
+// The length load in the loop condition is hoisted.
+function sum(a) {
+  let s = 0;
+  for (let i = 0; i < a.length; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+%PrepareFunctionForOptimization(sum);
+assertEquals(6, sum([1, 2, 3]));
+assertEquals(10, sum([1, 2, 3, 4]));
+%OptimizeMaglevOnNextCall(sum);
+assertEquals(6, sum([1, 2, 3]));
+assertEquals(0, sum([]));
+assertTrue(isMaglevved(sum));
+
+// An array with another map fails the (hoisted) map check.
+assertEquals(3.5, sum([1.5, 2]));
+assertEquals(6, sum([1, 2, 3]));
+
+// The loop writes to the object, so the field load isn't hoisted.
+function countDown(o) {
+  let n = 0;
+  while (o.x > 0) {
+    o.x--;
+    n++;
+  }
+  return n;
+}
+
+%PrepareFunctionForOptimization(countDown);
+assertEquals(3, countDown({x: 3}));
+%OptimizeMaglevOnNextCall(countDown);
+assertEquals(5, countDown({x: 5}));
+assertEquals(0, countDown({x: 0}));
+
+// The loop calls a function that can change the object.
+let obj = {limit: 4};
+function shrink() {
+  obj.limit--;
+}
+function callInLoop() {
+  let n = 0;
+  for (let i = 0; i < obj.limit; i++) {
+    shrink();
+    n++;
+  }
+  return n;
+}
+
+%PrepareFunctionForOptimization(shrink);
+%PrepareFunctionForOptimization(callInLoop);
+assertEquals(2, callInLoop());
+obj.limit = 4;
+%OptimizeMaglevOnNextCall(callInLoop);
+assertEquals(2, callInLoop());
@@ -0,0 +1,58 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --maglev --maglev-inlining
+// Flags: --maglev-polymorphic-inlining
+
+class A { get() { return this.x + 1; } }
+class B { get() { return this.x + 2; } }
+class C { get() { return this.x + 3; } }
+
+function call(o) {
+  return o.get();
+}
+
+%PrepareFunctionForOptimization(A.prototype.get);
+%PrepareFunctionForOptimization(B.prototype.get);
+%PrepareFunctionForOptimization(C.prototype.get);
+%PrepareFunctionForOptimization(call);
+let a = new A(); a.x = 10;
+let b = new B(); b.x = 20;
+let c = new C(); c.x = 30;
+for (let i = 0; i < 2; i++) {
+  assertEquals(11, call(a));
+  assertEquals(22, call(b));
+  assertEquals(33, call(c));
+}
+
+%OptimizeMaglevOnNextCall(call);
+assertEquals(11, call(a));
+assertEquals(22, call(b));
+assertEquals(33, call(c));
+assertTrue(isMaglevved(call));
+
+// A deopt in one of the inlined targets has to resume in the right function.
+c.x = 'x';
+assertEquals('x3', call(c));
+assertEquals(11, call(a));
+
+// Maps that share a target only need a single dispatch.
+function twice() { return this.y * 2; }
+function callTwice(o) {
+  return o.twice();
+}
+
+let d = { y: 1, twice };
+let e = { z: 0, y: 2, twice };
+let f = { y: 3, twice() { return -this.y; } };
+%PrepareFunctionForOptimization(twice);
+%PrepareFunctionForOptimization(f.twice);
+%PrepareFunctionForOptimization(callTwice);
+assertEquals(2, callTwice(d));
+assertEquals(4, callTwice(e));
+assertEquals(-3, callTwice(f));
+%OptimizeMaglevOnNextCall(callTwice);
+assertEquals(2, callTwice(d));
+assertEquals(4, callTwice(e));
+assertEquals(-3, callTwice(f));
@@ -0,0 +1,76 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --enable-experimental-regexp-engine
+// Flags: --experimental-regexp-engine-dfa
+
+// The experimental engine finds match boundaries with a lazily built DFA for
+// regexps without assertions and lookbehinds. It must find the same matches
+// and captures as the backtracking engine.
+
+function Check(source, flags, subject) {
+  const linear = new RegExp(source, flags + 'l');
+  const backtracking = new RegExp(source, flags);
+  assertEquals('EXPERIMENTAL', %RegexpTypeTag(linear));
+  assertNotEquals('EXPERIMENTAL', %RegexpTypeTag(backtracking));
+
+  const message = `/${source}/${flags} on "${subject}"`;
+  assertEquals(backtracking.exec(subject), linear.exec(subject), message);
+  assertEquals(backtracking.lastIndex, linear.lastIndex, message);
+  if (flags.includes('g')) {
+    assertEquals([...subject.matchAll(backtracking)],
+                 [...subject.matchAll(linear)], message);
+    assertEquals(subject.replace(backtracking, '<$&>'),
+                 subject.replace(linear, '<$&>'), message);
+  }
+}
+
+const patterns = [
+  '', 'abc', 'a|ab|abc', 'ab|a|abc', 'x*', 'x+?y', '(a+)(b*)c', '(?:ab|a)(b?)c',
+  '[a-c]{3,5}d', '(\\d+)-(\\d+)', 'a(b|c)*d', '(x)?y', '(a*)*b', '(?:a|b)*?c',
+  '(a|ab)(c|bcd)(d*)', 'é+', '[^a]+', '.*?z', 'ሴ\\w', '[x-ሴ]+',
+];
+
+const subjects = [
+  '', 'abc', 'xxabcabc', 'aab', 'xxy', 'aaabbbc', 'abbc abc ac', 'abcd',
+  '12-34 and 5-678', 'abcbcbd', 'y xy', 'aaab', 'bbbbc', 'abcd abcde',
+  'éété', 'aaxaa', 'xyz', 'ሴaሴ', 'bxĀy',
+];
+
+for (const source of patterns) {
+  for (const flags of ['', 'g', 'y']) {
+    for (const subject of subjects) {
+      Check(source, flags, subject);
+      // The same subject as a two-byte string.
+      Check(source, flags, ('ሴ' + subject).substring(1));
+    }
+  }
+}
+
+(function TestLongSubject() {
+  const subject = 'x'.repeat(10000) + 'abbbc' + 'y'.repeat(10000) + 'ac';
+  Check('a(b*)c', 'g', subject);
+  Check('a(?:b*)c', 'g', subject);
+  Check('zzz', 'g', subject);
+})();
+
+(function TestMemoryBudget() {
+  // The DFA for this regexp has exponentially many states, so the engine has
+  // to fall back to running the NFA.
+  let subject = '';
+  let seed = 17;
+  for (let i = 0; i < 5000; ++i) {
+    seed = (Math.imul(seed, 1103515245) + 12345) & 0x7fffffff;
+    subject += (seed & 0x100) ? 'a' : 'b';
+  }
+  Check('(?:a|b)*a(?:a|b){12}c', '', subject);
+  Check('(?:a|b)*a(?:a|b){12}', 'g', subject + 'c');
+})();
+
+(function TestAssertionsAndLookbehinds() {
+  // These don't use the DFA.
+  Check('^ab|b$', 'g', 'abab');
+  Check('\\bab', '', 'xab ab');
+  Check('(?<=x)ab', '', 'abxab');
+})();
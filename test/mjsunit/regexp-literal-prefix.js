@@ -0,0 +1,101 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-literal-prefix-search --js-regexp-modifiers
+
+// Regexps that start with a literal skip ahead to its occurrences before
+// running the matcher. This must not change any results.
+
+function TwoByte(s) {
+  // Prepending and stripping a two-byte character forces a two-byte subject.
+  return ('\u1234' + s).substring(1);
+}
+
+function Test(re, subject, expected_index, expected_match) {
+  for (const s of [subject, TwoByte(subject)]) {
+    re.lastIndex = 0;
+    const result = re.exec(s);
+    if (expected_index === -1) {
+      assertNull(result);
+    } else {
+      assertEquals(expected_index, result.index);
+      assertEquals(expected_match, result[0]);
+    }
+  }
+}
+
+(function TestPrefix() {
+  const padding = 'x'.repeat(1000);
+  Test(/ERROR: (\d+)/, padding + 'ERROR: 42' + padding, 1000, 'ERROR: 42');
+  Test(/ERROR: (\d+)/, padding + 'ERROR: x' + padding, -1);
+  Test(/ERROR: (\d+)/, padding + 'ERROR: x ERROR: 7', 1009, 'ERROR: 7');
+  Test(/ERROR: (\d+)/, padding, -1);
+  Test(/ERROR: (\d+)/, 'ERROR', -1);
+  Test(/(ab)(?:cd)e+f/, padding + 'abcdeeef', 1000, 'abcdeeef');
+  Test(/(ab)(?:cd)e+f/, padding + 'abcdf', -1);
+  Test(/été \w+/, padding + 'été chaud', 1000, 'été chaud');
+  // The prefix stops at the first non-one-byte character.
+  Test(/ab\u1234c/, padding + 'ab\u1234c', 1000, 'ab\u1234c');
+  Test(/ab\u1234c/, padding + 'abc', -1);
+})();
+
+(function TestCaptures() {
+  const result = /key=(\w+)(;)?/d.exec('xxx key=value; key=other');
+  assertEquals(['key=value;', 'value', ';'], [...result]);
+  assertEquals(4, result.index);
+  assertEquals([[4, 14], [8, 13], [13, 14]], [...result.indices]);
+})();
+
+(function TestLookbehindBeforePrefix() {
+  // Lookbehinds after the prefix can look at characters before the
+  // prefix search's start position.
+  Test(/ab(?<=xab)c/, 'yabc xabc', 5, 'abc');
+  Test(/ab(?<=xab)c/, 'yabc yabc', -1);
+  Test(/ab\b/, 'abc ab', 4, 'ab');
+})();
+
+(function TestGlobal() {
+  const re = /foo(\d)/g;
+  const s = 'foo1 bar foo2 foo foo3';
+  assertEquals(['foo1', 'foo2', 'foo3'], s.match(re));
+  assertEquals('<1> bar <2> foo <3>', s.replace(re, '<$1>'));
+  assertEquals(['1', '2', '3'], [...s.matchAll(re)].map(m => m[1]));
+  re.lastIndex = 5;
+  assertEquals(9, re.exec(s).index);
+  assertEquals(13, re.lastIndex);
+  re.lastIndex = 19;
+  assertNull(re.exec(s));
+  assertEquals(0, re.lastIndex);
+  re.lastIndex = s.length;
+  assertNull(re.exec(s));
+})();
+
+(function TestSticky() {
+  // Sticky regexps must only match at lastIndex.
+  const re = /foo/y;
+  const s = 'xfoo';
+  re.lastIndex = 0;
+  assertNull(re.exec(s));
+  re.lastIndex = 1;
+  assertEquals(1, re.exec(s).index);
+  assertEquals(['foo'], 'foo foo'.match(/fo(o)/y).slice(0, 1));
+})();
+
+(function TestIgnoreCase() {
+  Test(/abc\d/i, 'xx ABC1', 3, 'ABC1');
+  Test(/a(?i:bc)\d/, 'xx aBC1', 3, 'aBC1');
+  Test(/(?i:ab)c\d/, 'xx ABc1', 3, 'ABc1');
+})();
+
+(function TestQuantifiedPrefix() {
+  Test(/(?:ab)+c/, 'xababc', 1, 'ababc');
+  Test(/(?:ab)*c/, 'xc', 1, 'c');
+  Test(/(?:ab)?c/, 'xxc', 2, 'c');
+})();
+
+(function TestSearchAndSplit() {
+  assertEquals(6, 'hello world'.search(/wor\w/));
+  assertEquals(-1, 'hello world'.search(/word/));
+  assertEquals(['a', 'b', 'c'], 'a--b--c'.split(/--/));
+})();
@@ -0,0 +1,71 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Global replacements with a string collect all matches in one runtime call
+// for long subjects, and replace one match at a time for short ones. Both must
+// behave like replacing one match at a time.
+
+function ReplaceOneByOne(re, subject, replacement) {
+  const unicode = re.unicode || re.unicodeSets;
+  let result = '';
+  let last_end = 0;
+  re.lastIndex = 0;
+  let match;
+  while ((match = re.exec(subject)) !== null) {
+    result += subject.substring(last_end, match.index) + replacement;
+    last_end = match.index + match[0].length;
+    if (match[0].length === 0) {
+      const c = subject.codePointAt(re.lastIndex);
+      re.lastIndex += (unicode && c > 0xFFFF) ? 2 : 1;
+    }
+  }
+  return result + subject.substring(last_end);
+}
+
+function Check(re, subject, replacement) {
+  const expected = ReplaceOneByOne(re, subject, replacement);
+  re.lastIndex = 7;
+  assertEquals(expected, subject.replace(re, replacement));
+  assertEquals(0, re.lastIndex);
+}
+
+(function TestMatches() {
+  const subjects = ['', 'abc', 'a{{x}}b{{yy}}c{{}}', '{{a}}{{b}}', 'ሴ{{x}}ሴ'];
+  for (const subject of subjects) {
+    for (const replacement of ['', '-', 'ሴ', 'long replacement']) {
+      Check(/{{(\w*)}}/g, subject, replacement);
+      Check(/\w/g, subject, replacement);
+      Check(/x*/g, subject, replacement);
+      Check(/{{/gy, subject, replacement);
+    }
+  }
+})();
+
+(function TestEmptyMatchesAdvanceByCodePoint() {
+  const subject = 'a\u{1F600}b';
+  Check(/(?:)/g, subject, '-');
+  Check(/(?:)/gu, subject, '-');
+  assertEquals('-a-\u{1F600}-b-', subject.replace(/(?:)/gu, '-'));
+})();
+
+(function TestLastMatch() {
+  'a1b22c333'.replace(/(\d+)/g, 'x');
+  assertEquals('333', RegExp.lastMatch);
+  assertEquals('333', RegExp.$1);
+  assertEquals('a1b22c', RegExp.leftContext);
+})();
+
+(function TestSubstitutions() {
+  assertEquals('[a]-[b]', 'a-b'.replace(/(\w)/g, '[$1]'));
+  assertEquals('$-$', 'a-b'.replace(/\w/g, '$$'));
+  assertEquals('<a>-<b>', 'a-b'.replace(/(?<c>\w)/g, '<$<c>>'));
+})();
+
+(function TestLongSubject() {
+  const template = 'Hello {{name}}, you owe {{amount}}. '.repeat(5000);
+  const result = template.replace(/{{\w+}}/g, '?');
+  assertEquals('Hello ?, you owe ?. '.repeat(5000), result);
+  Check(/{{\w+}}/g, template, 'value');
+  Check(/{{\w+}}/g, ('ሴ' + template).substring(1), 'ሴ');
+})();
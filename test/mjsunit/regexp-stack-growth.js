@@ -0,0 +1,35 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --trace-regexp-stack --regexp-tier-up-ticks=0
+
+// The backtrack stack grows within a reserved region and keeps some of its
+// memory between executions. Executions that grow it, that start on a stack
+// that has grown before, or that are interleaved with executions on a smaller
+// stack must all find the same matches.
+
+function Backtracking(n) {
+  // Every 'a' pushes a backtrack entry, and the subject doesn't match.
+  return ['a'.repeat(n) + 'c', /^(?:a|b)*b$/];
+}
+
+(function TestGrowAndShrink() {
+  for (const n of [10, 10000, 100, 100000, 10, 100000]) {
+    const [subject, re] = Backtracking(n);
+    assertNull(re.exec(subject));
+    assertEquals(['a'.repeat(n) + 'b'], re.exec('a'.repeat(n) + 'b'));
+  }
+})();
+
+(function TestNestedExecutions() {
+  const [subject, re] = Backtracking(50000);
+  let calls = 0;
+  const result = 'x'.repeat(20).replace(/x/g, () => {
+    ++calls;
+    assertNull(re.exec(subject));
+    return 'y';
+  });
+  assertEquals(20, calls);
+  assertEquals('y'.repeat(20), result);
+})();
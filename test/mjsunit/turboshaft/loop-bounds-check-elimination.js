@@ -0,0 +1,66 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --allow-natives-syntax --turbofan --no-always-turbofan
+// Flags: --turboshaft-loop-bounds-check-elimination
+
+function sum(arr) {
+  let s = 0;
+  for (let i = 0; i < arr.length; i++) {
+    s += arr[i];
+  }
+  return s;
+}
+
+%PrepareFunctionForOptimization(sum);
+assertEquals(10, sum([1, 2, 3, 4]));
+%OptimizeFunctionOnNextCall(sum);
+assertEquals(10, sum([1, 2, 3, 4]));
+assertEquals(0, sum([]));
+assertOptimized(sum);
+
+function scale(ta, k) {
+  for (let i = 0; i < ta.length; i++) {
+    ta[i] = ta[i] * k;
+  }
+  return ta;
+}
+
+%PrepareFunctionForOptimization(scale);
+assertEquals([2, 4, 6], Array.from(scale(new Int32Array([1, 2, 3]), 2)));
+%OptimizeFunctionOnNextCall(scale);
+assertEquals([3, 6, 9], Array.from(scale(new Int32Array([1, 2, 3]), 3)));
+assertOptimized(scale);
+
+// The loop is bounded by the length of another array, so the bounds check on
+// {b} cannot be removed and has to trigger a deopt.
+function sumOther(a, b) {
+  let s = 0;
+  for (let i = 0; i < a.length; i++) {
+    s += b[i];
+  }
+  return s;
+}
+
+%PrepareFunctionForOptimization(sumOther);
+assertEquals(6, sumOther([0, 0, 0], [1, 2, 3]));
+%OptimizeFunctionOnNextCall(sumOther);
+assertEquals(6, sumOther([0, 0, 0], [1, 2, 3]));
+assertEquals(NaN, sumOther([0, 0, 0, 0], [1, 2, 3]));
+
+// The array shrinks during the loop: the length is reloaded at each iteration
+// so the check must still be correct.
+function popWhileIterating(arr) {
+  let s = 0;
+  for (let i = 0; i < arr.length; i++) {
+    s += arr[i];
+    if (i == 1) arr.length = 2;
+  }
+  return s;
+}
+
+%PrepareFunctionForOptimization(popWhileIterating);
+assertEquals(3, popWhileIterating([1, 2, 3, 4]));
+%OptimizeFunctionOnNextCall(popWhileIterating);
+assertEquals(3, popWhileIterating([1, 2, 3, 4]));
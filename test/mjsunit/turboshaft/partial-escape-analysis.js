@@ -0,0 +1,80 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --allow-natives-syntax --turbofan --no-always-turbofan
+// Flags: --turboshaft --turboshaft-partial-escape-analysis
+
+// The point only escapes on the cold path.
+let escaped;
+function maybeEscape(x, y, escape) {
+  let p = { x, y };
+  if (escape) escaped = p;
+  return p.x + p.y;
+}
+
+%PrepareFunctionForOptimization(maybeEscape);
+assertEquals(3, maybeEscape(1, 2, false));
+assertEquals(7, maybeEscape(3, 4, true));
+%OptimizeFunctionOnNextCall(maybeEscape);
+assertEquals(11, maybeEscape(5, 6, false));
+assertEquals(15, maybeEscape(7, 8, true));
+assertEquals(7, escaped.x);
+assertEquals(8, escaped.y);
+
+// Deoptimizing before the point escapes has to rematerialize it.
+function deoptBeforeEscape(x, y, deopt, escape) {
+  let p = { x, y };
+  if (deopt) %DeoptimizeNow();
+  if (escape) return p;
+  return x;
+}
+
+%PrepareFunctionForOptimization(deoptBeforeEscape);
+deoptBeforeEscape(1, 2, false, false);
+deoptBeforeEscape(1, 2, false, true);
+%OptimizeFunctionOnNextCall(deoptBeforeEscape);
+assertEquals(1, deoptBeforeEscape(1, 2, false, false));
+let p = deoptBeforeEscape(3, 4, true, true);
+assertEquals(3, p.x);
+assertEquals(4, p.y);
+
+// The same object has to be returned on all escaping paths.
+function sameObject(x, a, b) {
+  let p = { x };
+  let r1 = a ? p : null;
+  let r2 = b ? p : null;
+  return r1 === r2;
+}
+
+%PrepareFunctionForOptimization(sameObject);
+assertTrue(sameObject(1, true, true));
+assertFalse(sameObject(1, true, false));
+%OptimizeFunctionOnNextCall(sameObject);
+assertTrue(sameObject(1, true, true));
+assertFalse(sameObject(1, false, true));
+
+// Deoptimizing after the merge of the escaping path with the other one has to
+// reuse the object that escaped, including the stores done after the escape,
+// rather than recreating it.
+let escapedBeforeDeopt;
+function identity(o) { return o; }
+function deoptAfterEscape(x, escape, deopt) {
+  let p = { x };
+  if (escape) {
+    escapedBeforeDeopt = p;
+    p.x = x + 1;
+  }
+  // `identity` has no feedback, so this deopts in optimized code.
+  if (deopt) return identity(p);
+  return x;
+}
+
+%PrepareFunctionForOptimization(deoptAfterEscape);
+assertEquals(1, deoptAfterEscape(1, false, false));
+assertEquals(2, deoptAfterEscape(2, true, false));
+%OptimizeFunctionOnNextCall(deoptAfterEscape);
+assertEquals(3, deoptAfterEscape(3, false, false));
+let q = deoptAfterEscape(4, true, true);
+assertSame(escapedBeforeDeopt, q);
+assertEquals(5, q.x);
@@ -0,0 +1,8 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --no-wasm-generic-wrapper
+// Flags: --turboshaft-wasm-wrappers --dump-counters
+
+d8.file.execute('test/mjsunit/wasm/js-to-wasm-wrapper-fast-path.js');
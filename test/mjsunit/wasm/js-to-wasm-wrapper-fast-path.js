@@ -0,0 +1,91 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --no-wasm-generic-wrapper --dump-counters
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Compiled JS-to-wasm wrappers convert Smis, HeapNumbers, BigInts and
+// externrefs inline, and fall back to the generic conversions otherwise.
+function Instantiate() {
+  const builder = new WasmModuleBuilder();
+  builder.addFunction('mixed', makeSig(
+      [kWasmI32, kWasmI64, kWasmF64, kWasmExternRef], [kWasmI64]))
+      .addBody([
+        kExprLocalGet, 1,
+        kExprLocalGet, 0, kExprI64SConvertI32, kExprI64Add,
+        kExprLocalGet, 2, kExprI64SConvertF64, kExprI64Add,
+        kExprLocalGet, 3, kExprRefIsNull, kExprI64UConvertI32, kExprI64Add
+      ])
+      .exportFunc();
+  builder.addFunction('i64', kSig_l_l)
+      .addBody([kExprLocalGet, 0])
+      .exportFunc();
+  builder.addFunction('externref', kSig_r_r)
+      .addBody([kExprLocalGet, 0])
+      .exportFunc();
+  builder.addFunction('non_null_externref',
+                      makeSig([wasmRefType(kWasmExternRef)], [kWasmExternRef]))
+      .addBody([kExprLocalGet, 0])
+      .exportFunc();
+  return builder.instantiate();
+}
+
+(function TestI64Parameters() {
+  print(arguments.callee.name);
+  const {i64} = Instantiate().exports;
+  assertEquals(0n, i64(0n));
+  assertEquals(1n, i64(1n));
+  assertEquals(-1n, i64(-1n));
+  assertEquals(2n ** 63n - 1n, i64(2n ** 63n - 1n));
+  assertEquals(-(2n ** 63n), i64(-(2n ** 63n)));
+  // Values are truncated to 64 bits.
+  assertEquals(-(2n ** 63n), i64(2n ** 63n));
+  assertEquals(5n, i64(2n ** 64n + 5n));
+  assertEquals(-5n, i64(-(2n ** 64n) - 5n));
+  assertEquals(-1n, i64(2n ** 128n - 1n));
+  // Other values are converted with ToBigInt.
+  assertEquals(12n, i64('12'));
+  assertEquals(1n, i64(true));
+  assertThrows(() => i64(1), TypeError);
+  assertThrows(() => i64(1.5), TypeError);
+  assertThrows(() => i64(undefined), TypeError);
+})();
+
+(function TestExternRefParameters() {
+  print(arguments.callee.name);
+  const {externref, non_null_externref} = Instantiate().exports;
+  const obj = {};
+  for (const value of [obj, null, undefined, 1, 1.5, 'foo', 2n, Symbol()]) {
+    assertSame(value, externref(value));
+  }
+  assertSame(obj, non_null_externref(obj));
+  assertSame(undefined, non_null_externref(undefined));
+  assertThrows(() => non_null_externref(null), TypeError);
+})();
+
+(function TestMixedParameters() {
+  print(arguments.callee.name);
+  const {mixed} = Instantiate().exports;
+  assertEquals(6n, mixed(1, 2n, 3, {}));
+  assertEquals(7n, mixed(1, 2n, 3.5, null));
+  assertEquals(-(2n ** 63n) + 1n, mixed(1, 2n ** 63n, 0, {}));
+  // Each parameter can make the wrapper take the slow path.
+  assertEquals(7n, mixed('1', 2n, 3, null));
+  assertEquals(7n, mixed(1, '2', 3, null));
+  assertEquals(7n, mixed(1, 2n, '3', null));
+  assertThrows(() => mixed(1, 2, 3, null), TypeError);
+})();
+
+(function TestExportWrapperCacheStats() {
+  print(arguments.callee.name);
+  const first = Instantiate();
+  const hits = %WasmExportWrapperCacheHits();
+  const misses = %WasmExportWrapperCacheMisses();
+  // A second module with the same signatures reuses the cached wrappers.
+  const second = Instantiate();
+  assertTrue(%WasmExportWrapperCacheHits() > hits);
+  assertEquals(misses, %WasmExportWrapperCacheMisses());
+  assertEquals(first.exports.i64(3n), second.exports.i64(3n));
+})();
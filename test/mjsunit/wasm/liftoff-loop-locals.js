@@ -0,0 +1,189 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --liftoff --no-wasm-tier-up
+// Flags: --no-wasm-lazy-compilation --liftoff-cache-loop-locals
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+(function testSumLoop() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // Locals: 0 = n, 1 = i, 2 = i32 sum, 3 = i64 sum, 4 = f64 sum.
+  builder.addFunction('sum', kSig_d_i)
+      .addLocals(kWasmI32, 2)
+      .addLocals(kWasmI64, 1)
+      .addLocals(kWasmF64, 1)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 2, kExprLocalGet, 1, kExprI32Add, kExprLocalSet, 2,
+          kExprLocalGet, 3, kExprLocalGet, 1, kExprI64UConvertI32, kExprI64Add,
+          kExprLocalSet, 3,
+          kExprLocalGet, 4, kExprLocalGet, 1, kExprF64UConvertI32, kExprF64Add,
+          kExprLocalSet, 4,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+          kExprLocalGet, 0, kExprI32LtU,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 2, kExprF64UConvertI32,
+        kExprLocalGet, 3, kExprF64UConvertI64, kExprF64Add,
+        kExprLocalGet, 4, kExprF64Add
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertTrue(%IsLiftoffFunction(instance.exports.sum));
+  assertEquals(0, instance.exports.sum(0));
+  assertEquals(3 * 45, instance.exports.sum(10));
+  assertEquals(3 * 4950, instance.exports.sum(100));
+})();
+
+(function testSwapLocals() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // The two locals swap their registers on each iteration.
+  builder.addFunction('fib', kSig_i_i)
+      .addLocals(kWasmI32, 3)
+      .addBody([
+        kExprI32Const, 1, kExprLocalSet, 2,
+        kExprBlock, kWasmVoid,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 0, kExprI32Eqz, kExprBrIf, 1,
+            kExprLocalGet, 1, kExprLocalGet, 2, kExprI32Add, kExprLocalSet, 3,
+            kExprLocalGet, 2, kExprLocalSet, 1,
+            kExprLocalGet, 3, kExprLocalSet, 2,
+            kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub, kExprLocalSet, 0,
+            kExprBr, 0,
+          kExprEnd,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(0, instance.exports.fib(0));
+  assertEquals(1, instance.exports.fib(1));
+  assertEquals(55, instance.exports.fib(10));
+  assertEquals(6765, instance.exports.fib(20));
+})();
+
+(function testNestedLoopsWithMemoryAndGlobals() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1);
+  const global = builder.addGlobal(kWasmI32, true, false);
+  // Locals: 0 = n, 1 = i, 2 = j.
+  // Stores i * n + j at each index, and counts the stores in the global.
+  builder.addFunction('fill', kSig_v_i)
+      .addLocals(kWasmI32, 2)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprI32Const, 0, kExprLocalSet, 2,
+          kExprLoop, kWasmVoid,
+            kExprLocalGet, 1, kExprLocalGet, 0, kExprI32Mul,
+            kExprLocalGet, 2, kExprI32Add,
+            kExprI32Const, 2, kExprI32Shl,
+            kExprLocalGet, 1, kExprLocalGet, 0, kExprI32Mul,
+            kExprLocalGet, 2, kExprI32Add,
+            kExprI32StoreMem, 2, 0,
+            kExprGlobalGet, global.index, kExprI32Const, 1, kExprI32Add,
+            kExprGlobalSet, global.index,
+            kExprLocalGet, 2, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 2,
+            kExprLocalGet, 0, kExprI32LtU, kExprBrIf, 0,
+          kExprEnd,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+          kExprLocalGet, 0, kExprI32LtU, kExprBrIf, 0,
+        kExprEnd
+      ])
+      .exportFunc();
+  builder.addFunction('load', kSig_i_i)
+      .addBody([
+        kExprLocalGet, 0, kExprI32Const, 2, kExprI32Shl,
+        kExprI32LoadMem, 2, 0
+      ])
+      .exportFunc();
+  builder.addFunction('count', kSig_i_v)
+      .addBody([kExprGlobalGet, global.index])
+      .exportFunc();
+  const instance = builder.instantiate();
+  instance.exports.fill(20);
+  assertEquals(400, instance.exports.count());
+  for (let i = 0; i < 400; ++i) {
+    assertEquals(i, instance.exports.load(i));
+  }
+})();
+
+(function testLoopWithCall() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  const double = builder.addFunction('double', kSig_i_i)
+      .addBody([kExprLocalGet, 0, kExprLocalGet, 0, kExprI32Add]);
+  // Locals: 0 = n, 1 = i, 2 = sum.
+  builder.addFunction('sum_doubles', kSig_i_i)
+      .addLocals(kWasmI32, 2)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 2,
+          kExprLocalGet, 1, kExprCallFunction, double.index,
+          kExprI32Add, kExprLocalSet, 2,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+          kExprLocalGet, 0, kExprI32LtU, kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 2
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(90, instance.exports.sum_doubles(10));
+})();
+
+(function testMoreLocalsThanRegisters() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  const kNumSums = 20;
+  // Locals: 0 = n, 1 = i, 2.. = sums of i + k.
+  const body = [kExprLoop, kWasmVoid];
+  for (let k = 0; k < kNumSums; ++k) {
+    body.push(kExprLocalGet, 2 + k, kExprLocalGet, 1, kExprI32Add,
+              kExprI32Const, k, kExprI32Add, kExprLocalSet, 2 + k);
+  }
+  body.push(
+      kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalTee, 1,
+      kExprLocalGet, 0, kExprI32LtU, kExprBrIf, 0,
+      kExprEnd);
+  // Return the sums of all even {k} minus the sums of all odd {k}.
+  body.push(kExprI32Const, 0);
+  for (let k = 0; k < kNumSums; ++k) {
+    body.push(kExprLocalGet, 2 + k, k % 2 ? kExprI32Sub : kExprI32Add);
+  }
+  builder.addFunction('sums', kSig_i_i)
+      .addLocals(kWasmI32, 1 + kNumSums)
+      .addBody(body)
+      .exportFunc();
+  const instance = builder.instantiate();
+  // Each pair of sums differs by n.
+  assertEquals(-10 * 10, instance.exports.sums(10));
+  assertEquals(-10 * 100, instance.exports.sums(100));
+})();
+
+(function testLoopWithParameter() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  const loop_sig = builder.addType(kSig_i_i);
+  // Counts down the loop parameter, and counts the iterations in local 1.
+  builder.addFunction('count', kSig_i_i)
+      .addLocals(kWasmI32, 1)
+      .addBody([
+        kExprLocalGet, 0,
+        kExprLoop, loop_sig,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Add, kExprLocalSet, 1,
+          kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 0,
+          kExprLocalGet, 0, kExprBrIf, 0,
+        kExprEnd,
+        kExprDrop,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(1, instance.exports.count(1));
+  assertEquals(17, instance.exports.count(17));
+})();
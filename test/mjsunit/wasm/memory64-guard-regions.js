@@ -0,0 +1,107 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --experimental-wasm-memory64 --allow-natives-syntax
+// Flags: --wasm-memory64-guarded-max-gb=1
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+const GB = 1024 * 1024 * 1024;
+const kNumPages = 2;
+const kMemSize = kNumPages * kPageSize;
+
+// Memories of at most 1GB use guard regions (if the trap handler is enabled),
+// bigger ones use explicit bounds checks. The results must not differ.
+function AddLoadFunctions(builder) {
+  builder.addFunction('load', kSig_i_l)
+      .addBody([kExprLocalGet, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction('load_offset', kSig_i_l)
+      .addBody([
+        kExprLocalGet, 0, kExprI32LoadMem, 0, ...wasmUnsignedLeb(kPageSize)
+      ])
+      .exportFunc();
+  builder.addFunction('load_u32', kSig_i_i)
+      .addBody([
+        kExprLocalGet, 0, kExprI64UConvertI32, kExprI32LoadMem, 0, 0
+      ])
+      .exportFunc();
+  builder.addFunction('load_masked', kSig_i_l)
+      .addBody([
+        kExprLocalGet, 0, ...wasmI64Const(0xffffff), kExprI64And,
+        kExprI32LoadMem, 0, 0
+      ])
+      .exportFunc();
+}
+
+function CheckLoads(instance, memory) {
+  const view = new DataView(memory.buffer);
+  view.setInt32(0, 11, true);
+  view.setInt32(kPageSize, 22, true);
+  view.setInt32(kMemSize - 4, 33, true);
+  const {load, load_offset, load_u32, load_masked} = instance.exports;
+
+  assertEquals(11, load(0n));
+  assertEquals(22, load(BigInt(kPageSize)));
+  assertEquals(33, load(BigInt(kMemSize - 4)));
+  assertEquals(22, load_offset(0n));
+  assertEquals(33, load_offset(BigInt(kPageSize - 4)));
+  assertEquals(11, load_u32(0));
+  assertEquals(33, load_u32(kMemSize - 4));
+  assertEquals(11, load_masked(0n));
+  assertEquals(22, load_masked(BigInt(kPageSize) + (1n << 40n)));
+
+  const oob_indexes = [
+    kMemSize - 3, kMemSize, 16 * kPageSize, GB - 4, GB, 2 * GB, 4 * GB
+  ].map(BigInt).concat([1n << 40n, (1n << 63n) - 1n, -1n, -4n]);
+  for (const index of oob_indexes) {
+    assertTraps(kTrapMemOutOfBounds, () => load(index));
+    assertTraps(kTrapMemOutOfBounds, () => load_offset(index));
+    if (index >= 0n && index < (1n << 32n)) {
+      assertTraps(kTrapMemOutOfBounds, () => load_u32(Number(index)));
+    }
+  }
+  assertTraps(kTrapMemOutOfBounds, () => load_u32(-1));
+  assertTraps(kTrapMemOutOfBounds, () => load_masked(BigInt(kMemSize)));
+  assertTraps(kTrapMemOutOfBounds, () => load_masked(-1n));
+}
+
+function CheckLoadsInAllTiers(instance, memory) {
+  CheckLoads(instance, memory);
+  for (const name of ['load', 'load_offset', 'load_u32', 'load_masked']) {
+    %WasmTierUpFunction(instance.exports[name]);
+  }
+  CheckLoads(instance, memory);
+}
+
+(function TestGuardedMemory() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory64(kNumPages, 16);
+  builder.exportMemoryAs('memory');
+  AddLoadFunctions(builder);
+  const instance = builder.instantiate();
+  CheckLoadsInAllTiers(instance, instance.exports.memory);
+})();
+
+(function TestMemoryBiggerThanGuardedSize() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory64(kNumPages, 2 * GB / kPageSize);
+  builder.exportMemoryAs('memory');
+  AddLoadFunctions(builder);
+  const instance = builder.instantiate();
+  CheckLoadsInAllTiers(instance, instance.exports.memory);
+})();
+
+(function TestImportedMemoryWithSmallerMaximum() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addImportedMemory('m', 'memory', kNumPages, 16, false, true);
+  AddLoadFunctions(builder);
+  const memory = new WebAssembly.Memory(
+      {initial: kNumPages, maximum: kNumPages, index: 'i64'});
+  const instance = builder.instantiate({m: {memory}});
+  CheckLoadsInAllTiers(instance, memory);
+})();
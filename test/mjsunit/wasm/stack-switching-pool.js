@@ -0,0 +1,42 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --experimental-wasm-jspi --expose-gc
+// Flags: --wasm-stack-switching-stack-size=100 --dump-counters
+
+d8.file.execute("test/mjsunit/wasm/wasm-module-builder.js");
+
+// The stacks of collected continuations are reused by new suspendable calls.
+(function TestStackPoolReuse() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  builder.addGlobal(kWasmI32, true, false).exportAs('g');
+  import_index = builder.addImport('m', 'import', kSig_i_v);
+  builder.addFunction("test", kSig_i_v)
+      .addBody([
+          kExprGlobalGet, 0,
+          kExprCallFunction, import_index, // suspend
+          kExprI32Add,
+          kExprGlobalSet, 0,
+          kExprGlobalGet, 0]).exportFunc();
+  let js_import = new WebAssembly.Suspending(() => Promise.resolve(1));
+  let instance = builder.instantiate({m: {import: js_import}});
+  let wrapped_export = WebAssembly.promising(instance.exports.test);
+
+  async function RunAll() {
+    for (let i = 0; i < 10; ++i) {
+      await wrapped_export();
+    }
+  }
+
+  assertPromiseResult(RunAll().then(() => {
+    assertEquals(10, instance.exports.g.value);
+    gc();
+    const hits = %WasmStackPoolHits();
+    return RunAll().then(() => {
+      assertTrue(%WasmStackPoolHits() > hits);
+      assertEquals(20, instance.exports.g.value);
+    });
+  }));
+})();
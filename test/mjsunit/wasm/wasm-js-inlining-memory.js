@@ -0,0 +1,147 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbofan
+// Flags: --no-always-turbofan --no-always-sparkplug
+
+d8.file.execute("test/mjsunit/wasm/wasm-module-builder.js");
+
+function testOptimized(run, fctToOptimize) {
+  fctToOptimize = fctToOptimize ?? run;
+  %PrepareFunctionForOptimization(fctToOptimize);
+  for (let i = 0; i < 10; ++i) {
+    run();
+  }
+  %OptimizeFunctionOnNextCall(fctToOptimize);
+  run();
+  assertOptimized(fctToOptimize);
+}
+
+// Small accessors on linear memory and arithmetic helpers are inlined into
+// JavaScript.
+function createModule() {
+  let builder = new WasmModuleBuilder();
+  builder.addMemory(1, 4);
+  builder.exportMemoryAs('memory');
+  builder.addFunction('getI32', kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprI32LoadMem, 2, 0])
+    .exportFunc();
+  builder.addFunction('getU8', kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprI32LoadMem8U, 0, 0])
+    .exportFunc();
+  builder.addFunction('getI16', kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprI32LoadMem16S, 1, 0])
+    .exportFunc();
+  builder.addFunction('getF64At8', kSig_d_i)
+    .addBody([kExprLocalGet, 0, kExprF64LoadMem, 3, 8])
+    .exportFunc();
+  builder.addFunction('setI32', kSig_v_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32StoreMem, 2, 0])
+    .exportFunc();
+  builder.addFunction('setF32', makeSig([kWasmI32, kWasmF32], []))
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprF32StoreMem, 2, 0])
+    .exportFunc();
+  builder.addFunction('getF32', makeSig([kWasmI32], [kWasmF32]))
+    .addBody([kExprLocalGet, 0, kExprF32LoadMem, 2, 0])
+    .exportFunc();
+  builder.addFunction('scaledIndex', kSig_i_ii)
+    .addBody([
+      kExprLocalGet, 0, kExprI32Const, 2, kExprI32Shl,
+      kExprLocalGet, 1, kExprI32Add
+    ])
+    .exportFunc();
+  builder.addFunction('shr', kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32ShrU])
+    .exportFunc();
+  builder.addFunction('geU', kSig_i_ii)
+    .addBody([kExprLocalGet, 0, kExprLocalGet, 1, kExprI32GeU])
+    .exportFunc();
+  builder.addFunction('isZero', kSig_i_i)
+    .addBody([kExprLocalGet, 0, kExprI32Eqz])
+    .exportFunc();
+  builder.addFunction('lerp', makeSig([kWasmF64, kWasmF64], [kWasmF64]))
+    .addBody([
+      kExprLocalGet, 0, kExprLocalGet, 1, kExprF64Add,
+      ...wasmF64Const(0.5), kExprF64Mul
+    ])
+    .exportFunc();
+  return builder.instantiate({}).exports;
+}
+
+(function TestInliningLoadsAndStores() {
+  print(arguments.callee.name);
+  const wasm = createModule();
+  const view = new DataView(wasm.memory.buffer);
+  view.setInt32(16, 0x12345678, true);
+  view.setInt16(20, -2, true);
+  view.setFloat64(32, 2.5, true);
+
+  testOptimized(() => {
+    assertEquals(0x12345678, wasm.getI32(16));
+    assertEquals(0x78, wasm.getU8(16));
+    assertEquals(0x12, wasm.getU8(19));
+    assertEquals(-2, wasm.getI16(20));
+    assertEquals(2.5, wasm.getF64At8(24));
+    // Unaligned access.
+    assertEquals(0xfffe1234, wasm.getI32(18) >>> 0);
+  });
+
+  testOptimized(() => {
+    for (let i = 0; i < 8; ++i) {
+      wasm.setI32(64 + 4 * i, i * 3);
+    }
+    for (let i = 0; i < 8; ++i) {
+      assertEquals(i * 3, wasm.getI32(64 + 4 * i));
+    }
+    wasm.setF32(128, 1.5);
+    assertEquals(1.5, wasm.getF32(128));
+  });
+})();
+
+(function TestInliningArithmetic() {
+  print(arguments.callee.name);
+  const wasm = createModule();
+  testOptimized(() => {
+    assertEquals(13, wasm.scaledIndex(3, 1));
+    assertEquals(-4, wasm.scaledIndex(-1, 0));
+    assertEquals(0x7fffffff, wasm.shr(-1, 33));
+    assertEquals(1, wasm.geU(-1, 1));
+    assertEquals(0, wasm.geU(1, -1));
+    assertEquals(1, wasm.isZero(0));
+    assertEquals(0, wasm.isZero(7));
+    assertEquals(1.5, wasm.lerp(1, 2));
+  });
+})();
+
+(function TestInliningOutOfBounds() {
+  print(arguments.callee.name);
+  const wasm = createModule();
+  const kPageSize = 65536;
+  const getAtEnd = () => wasm.getI32(kPageSize - 4);
+  const getOOB = () => wasm.getI32(kPageSize - 3);
+  const getNegative = () => wasm.getI32(-1);
+  const getOffsetOOB = () => wasm.getF64At8(kPageSize - 8);
+  const setOOB = () => wasm.setI32(kPageSize, 1);
+
+  testOptimized(() => assertEquals(0, getAtEnd()), getAtEnd);
+  testOptimized(() => assertTraps(kTrapMemOutOfBounds, getOOB), getOOB);
+  testOptimized(() => assertTraps(kTrapMemOutOfBounds, getNegative),
+                getNegative);
+  testOptimized(() => assertTraps(kTrapMemOutOfBounds, getOffsetOOB),
+                getOffsetOOB);
+  testOptimized(() => assertTraps(kTrapMemOutOfBounds, setOOB), setOOB);
+})();
+
+(function TestInliningMemoryGrow() {
+  print(arguments.callee.name);
+  const wasm = createModule();
+  const kPageSize = 65536;
+  const getSecondPage = () => wasm.getI32(kPageSize);
+  testOptimized(() => assertTraps(kTrapMemOutOfBounds, getSecondPage),
+                getSecondPage);
+  // The inlined accesses must not cache the memory start and size.
+  wasm.memory.grow(1);
+  new DataView(wasm.memory.buffer).setInt32(kPageSize, 42, true);
+  assertEquals(42, getSecondPage());
+})();
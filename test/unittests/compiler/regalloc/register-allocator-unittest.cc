@@ -310,6 +310,53 @@ TEST_F(RegisterAllocatorTest, RegressionPhisNeedTooManyRegisters) {
   Allocate();
 }
 
+TEST_F(RegisterAllocatorTest, FastAllocationLoopPhisWithSpills) {
+  // Same as above, but with the cheaper heuristics used for large functions.
+  FlagScope<int> fast_allocation(
+      &v8_flags.turbo_fast_register_allocation_threshold, 1);
+  const size_t kNumRegs = 3;
+  const size_t kParams = kNumRegs + 1;
+  SetNumRegs(kNumRegs, kNumRegs);
+
+  StartBlock();
+  auto constant = DefineConstant();
+  VReg parameters[kParams];
+  for (size_t i = 0; i < arraysize(parameters); ++i) {
+    parameters[i] = DefineConstant();
+  }
+  EndBlock();
+
+  PhiInstruction* phis[kParams];
+  {
+    StartLoop(2);
+
+    StartBlock();
+    for (size_t i = 0; i < arraysize(parameters); ++i) {
+      phis[i] = Phi(parameters[i], 2);
+    }
+    for (size_t i = 0; i < arraysize(parameters); ++i) {
+      auto result = EmitOI(Same(), Reg(phis[i]), Use(constant));
+      SetInput(phis[i], 1, result);
+    }
+    EndBlock(Branch(Reg(DefineConstant()), 1, 2));
+
+    StartBlock();
+    EndBlock(Jump(-1));
+
+    EndLoop();
+  }
+
+  StartBlock();
+  TestOperand merged[kParams];
+  for (size_t i = 0; i < arraysize(parameters); ++i) {
+    merged[i] = Use(phis[i]);
+  }
+  Return(EmitCall(Slot(-1), kParams, merged));
+  EndBlock();
+
+  Allocate();
+}
+
 TEST_F(RegisterAllocatorTest, SpillPhi) {
   StartBlock();
   EndBlock(Branch(Imm(), 1, 2));
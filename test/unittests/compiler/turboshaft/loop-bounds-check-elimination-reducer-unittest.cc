@@ -0,0 +1,119 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/copying-phase.h"
+#include "src/compiler/turboshaft/loop-bounds-check-elimination-reducer.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "test/unittests/compiler/turboshaft/reducer-test.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+class LoopBoundsCheckEliminationReducerTest : public ReducerTest {};
+
+enum class Increment {
+  kWrapping,
+  // The increment deopts on overflow.
+  kOverflowChecked,
+  // The increment computes an overflow bit, but doesn't deopt on it.
+  kOverflowIgnored
+};
+
+// Builds `for (i = init; i < length; i += increment) a[i]`, where the bounds
+// check of `a[i]` is against `length`, or against an unrelated limit if
+// {check_other_limit}.
+template <typename AssemblerT>
+void BuildLoopWithBoundsCheck(AssemblerT& Asm, int32_t init, int32_t increment,
+                              Increment increment_kind,
+                              bool check_other_limit) {
+  V<Word32> length = __ UntagSmi(V<Smi>::Cast(Asm.GetParameter(0)));
+  V<Word32> other_length = __ UntagSmi(V<Smi>::Cast(Asm.GetParameter(1)));
+  V<Word32> check_limit = check_other_limit ? other_length : length;
+
+  ScopedVariable<Word32, typename AssemblerT::Assembler> index(&Asm, init);
+  WHILE(__ Int32LessThan(index, length)) {
+    __ DeoptimizeIfNot(__ Uint32LessThan(index, check_limit),
+                       Asm.BuildFrameState(), DeoptimizeReason::kOutOfBounds,
+                       FeedbackSource());
+    if (increment_kind == Increment::kWrapping) {
+      index = __ Word32Add(index, increment);
+    } else {
+      auto add = __ Int32AddCheckOverflow(index, increment);
+      if (increment_kind == Increment::kOverflowChecked) {
+        __ DeoptimizeIf(__ template Projection<1>(add), Asm.BuildFrameState(),
+                        DeoptimizeReason::kOverflow, FeedbackSource());
+      }
+      index = __ template Projection<0>(add);
+    }
+  }
+  __ Return(__ TagSmi(index));
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest, RemovesCheckOnInductionVariable) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, 0, 1, Increment::kWrapping, false);
+  });
+
+  ASSERT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 0u);
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest,
+       RemovesCheckOnOverflowCheckedInductionVariable) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, 3, 4, Increment::kOverflowChecked, false);
+  });
+
+  ASSERT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 2u);
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  // Only the overflow check remains.
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest,
+       KeepsCheckOnIncrementWithIgnoredOverflow) {
+  // The overflow bit of `i + 4` is computed but doesn't deopt, so `i` can
+  // wrap around like with a wrapping increment.
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, 3, 4, Increment::kOverflowIgnored, false);
+  });
+
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest, KeepsCheckOnWrappingIncrement) {
+  // `i + 2` could wrap around to a negative value that passes `i < length`.
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, 0, 2, Increment::kWrapping, false);
+  });
+
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest, KeepsCheckOnNegativeInit) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, -1, 1, Increment::kWrapping, false);
+  });
+
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+}
+
+TEST_F(LoopBoundsCheckEliminationReducerTest, KeepsCheckAgainstOtherLimit) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    BuildLoopWithBoundsCheck(Asm, 0, 1, Increment::kWrapping, true);
+  });
+
+  test.Run<LoopBoundsCheckEliminationReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 1u);
+}
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,164 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/copying-phase.h"
+#include "src/compiler/turboshaft/loop-bounds-check-elimination-reducer.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/partial-escape-analysis-reducer.h"
+#include "test/unittests/compiler/turboshaft/reducer-test.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+class PartialEscapeAnalysisReducerTest : public ReducerTest {
+ public:
+  PartialEscapeAnalysisReducerTest()
+      : ReducerTest(),
+        flag_partial_escape_analysis_(
+            &v8_flags.turboshaft_partial_escape_analysis, true) {}
+
+  // Returns true if the only Allocate of {test} is in its start block.
+  static bool AllocatesInStartBlock(TestInstance& test) {
+    Graph& graph = test.graph();
+    for (OpIndex index : graph.AllOperationIndices()) {
+      if (graph.Get(index).Is<AllocateOp>()) {
+        return graph.BlockOf(index) == graph.StartBlock().index();
+      }
+    }
+    UNREACHABLE();
+  }
+
+ private:
+  const FlagScope<bool> flag_partial_escape_analysis_;
+};
+
+// Allocates a 2-field object initialized with {first} and {second}.
+template <typename AssemblerT>
+V<HeapObject> AllocatePair(AssemblerT& Asm, V<Object> first,
+                           V<Object> second) {
+  Uninitialized<HeapObject> pair =
+      __ template Allocate<HeapObject>(2 * kTaggedSize, AllocationType::kYoung);
+  __ Initialize(pair, first, MemoryRepresentation::AnyTagged(),
+                WriteBarrierKind::kNoWriteBarrier, 0);
+  __ Initialize(pair, second, MemoryRepresentation::AnyTagged(),
+                WriteBarrierKind::kNoWriteBarrier, kTaggedSize);
+  return __ FinishInitialization(std::move(pair));
+}
+
+// Allocates a 2-field object initialized with the parameters.
+template <typename AssemblerT>
+V<HeapObject> AllocatePair(AssemblerT& Asm) {
+  return AllocatePair(Asm, Asm.GetParameter(0), Asm.GetParameter(1));
+}
+
+template <typename AssemblerT>
+V<Word32> IsZero(AssemblerT& Asm, V<Object> value) {
+  return __ Word32Equal(__ UntagSmi(V<Smi>::Cast(value)), 0);
+}
+
+TEST_F(PartialEscapeAnalysisReducerTest, SinksAllocationToEscapingBranch) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    V<HeapObject> pair = AllocatePair(Asm);
+    IF (IsZero(Asm, Asm.GetParameter(0))) {
+      __ Return(pair);
+    }
+    __ Return(__ SmiConstant(Smi::zero()));
+  });
+
+  ASSERT_TRUE(AllocatesInStartBlock(test));
+  test.Run<PartialEscapeAnalysisReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kAllocate), 1u);
+  EXPECT_EQ(test.CountOp(Opcode::kStore), 2u);
+  EXPECT_FALSE(AllocatesInStartBlock(test));
+}
+
+TEST_F(PartialEscapeAnalysisReducerTest, SinksAllocationWithComputedFields) {
+  // The sum is only used by the initializing store, which is skipped, and
+  // has to be emitted nonetheless for the materialization.
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    V<Word32> x = __ UntagSmi(V<Smi>::Cast(Asm.GetParameter(0)));
+    V<Word32> y = __ UntagSmi(V<Smi>::Cast(Asm.GetParameter(1)));
+    V<Word32> sum = __ Word32Add(x, y);
+    V<HeapObject> pair =
+        AllocatePair(Asm, __ TagSmi(sum), __ SmiConstant(Smi::zero()));
+    IF (IsZero(Asm, Asm.GetParameter(0))) {
+      __ Return(pair);
+    }
+    __ Return(__ SmiConstant(Smi::zero()));
+  });
+
+  test.Run<PartialEscapeAnalysisReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kAllocate), 1u);
+  EXPECT_EQ(test.CountOp(Opcode::kStore), 2u);
+  EXPECT_EQ(test.CountOp(Opcode::kWordBinop), 1u);
+  EXPECT_FALSE(AllocatesInStartBlock(test));
+}
+
+TEST_F(PartialEscapeAnalysisReducerTest,
+       MaterializesWhenFirstOperationIsRemoved) {
+  // The escaping branch starts with a bounds check that
+  // LoopBoundsCheckEliminationReducer removes before it reaches
+  // PartialEscapeAnalysisReducer.
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    V<Word32> length = __ UntagSmi(V<Smi>::Cast(Asm.GetParameter(0)));
+    ScopedVariable<Word32, TestInstance::Assembler> index(&Asm, 0);
+    WHILE(__ Int32LessThan(index, length)) {
+      V<HeapObject> pair = AllocatePair(Asm);
+      auto frame_state = Asm.BuildFrameState();
+      V<Word32> in_bounds = __ Uint32LessThan(index, length);
+      IF (IsZero(Asm, Asm.GetParameter(1))) {
+        __ DeoptimizeIfNot(in_bounds, frame_state,
+                           DeoptimizeReason::kOutOfBounds, FeedbackSource());
+        __ Return(pair);
+      }
+      index = __ Word32Add(index, 1);
+    }
+    __ Return(__ SmiConstant(Smi::zero()));
+  });
+
+  test.Run<LoopBoundsCheckEliminationReducer, PartialEscapeAnalysisReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kDeoptimizeIf), 0u);
+  EXPECT_EQ(test.CountOp(Opcode::kAllocate), 1u);
+  EXPECT_EQ(test.CountOp(Opcode::kStore), 2u);
+}
+
+TEST_F(PartialEscapeAnalysisReducerTest, KeepsAllocationEscapingOnAllPaths) {
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    V<HeapObject> pair = AllocatePair(Asm);
+    IF (IsZero(Asm, Asm.GetParameter(0))) {
+      __ Return(pair);
+    }
+    __ Return(__ TagSmi(__ TaggedEqual(pair, Asm.GetParameter(1))));
+  });
+
+  test.Run<PartialEscapeAnalysisReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kAllocate), 1u);
+  EXPECT_TRUE(AllocatesInStartBlock(test));
+}
+
+TEST_F(PartialEscapeAnalysisReducerTest, KeepsAllocationEscapingInLoop) {
+  // Sinking the allocation into the loop would allocate a new object at each
+  // iteration.
+  auto test = CreateFromGraph(2, [](auto& Asm) {
+    V<HeapObject> pair = AllocatePair(Asm);
+    ScopedVariable<Word32, TestInstance::Assembler> index(&Asm, 0);
+    WHILE(__ Int32LessThan(index, 10)) {
+      IF (IsZero(Asm, Asm.GetParameter(1))) {
+        __ Return(pair);
+      }
+      index = __ Word32Add(index, 1);
+    }
+    __ Return(__ SmiConstant(Smi::zero()));
+  });
+
+  test.Run<PartialEscapeAnalysisReducer>();
+  EXPECT_EQ(test.CountOp(Opcode::kAllocate), 1u);
+  EXPECT_TRUE(AllocatesInStartBlock(test));
+}
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
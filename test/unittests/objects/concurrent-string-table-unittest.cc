@@ -0,0 +1,136 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "src/handles/handles-inl.h"
+#include "src/handles/local-handles-inl.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope-inl.h"
+#include "src/objects/string-table.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+
+using ConcurrentStringTableTest = TestWithContext;
+
+namespace internal {
+
+namespace {
+
+std::string StringName(const char* prefix, int index) {
+  return std::string(prefix) + std::to_string(index);
+}
+
+// Internalizes the strings "<prefix><i>" for 0 <= i < count on a background
+// thread.
+class InternalizerThread final : public ParkingThread {
+ public:
+  InternalizerThread(Isolate* isolate, const char* prefix, int count,
+                     ParkingSemaphore* sema_ready,
+                     ParkingSemaphore* sema_start)
+      : ParkingThread(base::Thread::Options("InternalizerThread")),
+        isolate_(isolate),
+        prefix_(prefix),
+        count_(count),
+        sema_ready_(sema_ready),
+        sema_start_(sema_start) {}
+
+  void Run() override {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_isolate);
+
+    sema_ready_->Signal();
+    sema_start_->ParkedWait(&local_isolate);
+
+    for (int i = 0; i < count_; ++i) {
+      LocalHandleScope handle_scope(&local_isolate);
+      std::string name = StringName(prefix_, i);
+      Handle<String> string = local_isolate.factory()->InternalizeString(
+          base::OneByteVector(name.c_str(), name.length()));
+      strings_.push_back(local_isolate.heap()->NewPersistentHandle(string));
+    }
+    persistent_handles_ = local_isolate.heap()->DetachPersistentHandles();
+  }
+
+  Handle<String> string(int index) const { return strings_[index]; }
+
+ private:
+  Isolate* isolate_;
+  const char* prefix_;
+  int count_;
+  ParkingSemaphore* sema_ready_;
+  ParkingSemaphore* sema_start_;
+  std::vector<Handle<String>> strings_;
+  std::unique_ptr<PersistentHandles> persistent_handles_;
+};
+
+// Runs one InternalizerThread per prefix, all starting at the same time.
+std::vector<std::unique_ptr<InternalizerThread>> InternalizeConcurrently(
+    Isolate* isolate, const std::vector<const char*>& prefixes, int count) {
+  ParkingSemaphore sema_ready(0);
+  ParkingSemaphore sema_start(0);
+  std::vector<std::unique_ptr<InternalizerThread>> threads;
+  for (const char* prefix : prefixes) {
+    auto thread = std::make_unique<InternalizerThread>(
+        isolate, prefix, count, &sema_ready, &sema_start);
+    CHECK(thread->Start());
+    threads.push_back(std::move(thread));
+  }
+
+  LocalIsolate* local_isolate = isolate->main_thread_local_isolate();
+  for (size_t i = 0; i < threads.size(); ++i) {
+    sema_ready.ParkedWait(local_isolate);
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    sema_start.Signal();
+  }
+  ParkingThread::ParkedJoinAll(local_isolate, threads);
+  return threads;
+}
+
+}  // namespace
+
+TEST_F(ConcurrentStringTableTest, SameStringsAreInsertedOnce) {
+  constexpr int kThreads = 4;
+  constexpr int kStrings = 5000;
+
+  std::vector<const char*> prefixes(kThreads, "same-string-");
+  auto threads = InternalizeConcurrently(i_isolate(), prefixes, kStrings);
+
+  HandleScope handle_scope(i_isolate());
+  Factory* factory = i_isolate()->factory();
+  for (int i = 0; i < kStrings; ++i) {
+    Handle<String> string = factory->InternalizeString(
+        factory->NewStringFromAsciiChecked(StringName(prefixes[0], i).c_str()));
+    for (const auto& thread : threads) {
+      EXPECT_EQ(*string, *thread->string(i));
+    }
+  }
+}
+
+TEST_F(ConcurrentStringTableTest, DifferentStringsAreAllInserted) {
+  // Enough strings for the table to be resized while the threads insert.
+  constexpr int kStrings = 20000;
+
+  std::vector<const char*> prefixes = {"first-", "second-", "third-",
+                                       "fourth-"};
+  auto threads = InternalizeConcurrently(i_isolate(), prefixes, kStrings);
+
+  HandleScope handle_scope(i_isolate());
+  Factory* factory = i_isolate()->factory();
+  for (size_t t = 0; t < prefixes.size(); ++t) {
+    for (int i = 0; i < kStrings; ++i) {
+      Handle<String> string =
+          factory->InternalizeString(factory->NewStringFromAsciiChecked(
+              StringName(prefixes[t], i).c_str()));
+      EXPECT_EQ(*string, *threads[t]->string(i));
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
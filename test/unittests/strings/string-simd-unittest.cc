@@ -0,0 +1,188 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-simd.h"
+
+#include <vector>
+
+#include "src/base/utils/random-number-generator.h"
+#include "src/objects/string.h"
+#include "src/strings/char-predicates-inl.h"
+#include "src/strings/string-case.h"
+#include "src/strings/unicode-decoder.h"
+#include "src/utils/utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Runs |test| with every kind of kernel that the CPU supports. With kNone the
+// callers use their scalar loops, which the kernels are checked against.
+template <typename Test>
+void ForEachSupportedKind(Test test) {
+  StringSimd::Kind initial_kind = StringSimd::kind();
+  for (StringSimd::Kind kind :
+       {StringSimd::Kind::kNone, StringSimd::Kind::kSSE,
+        StringSimd::Kind::kAVX2, StringSimd::Kind::kNeon}) {
+    if (!StringSimd::IsSupported(kind)) continue;
+    StringSimd::SetKindForTesting(kind);
+    test();
+  }
+  StringSimd::SetKindForTesting(initial_kind);
+}
+
+// Lengths around the multiples of the vector sizes.
+constexpr int kLengths[] = {0,  1,  15, 16, 17, 31, 32,  33,
+                            63, 64, 65, 97, 128, 200, 1000};
+
+std::vector<uint8_t> AsciiChars(base::RandomNumberGenerator* rng,
+                                int length) {
+  std::vector<uint8_t> chars(length);
+  for (uint8_t& c : chars) c = ' ' + rng->NextInt('~' - ' ' + 1);
+  return chars;
+}
+
+}  // namespace
+
+TEST(StringSimdTest, NonAsciiStart) {
+  base::RandomNumberGenerator rng(42);
+  for (int length : kLengths) {
+    std::vector<uint8_t> chars = AsciiChars(&rng, length);
+    for (int non_ascii = 0; non_ascii <= length; ++non_ascii) {
+      std::vector<uint8_t> copy = chars;
+      if (non_ascii < length) copy[non_ascii] = 0x80 | rng.NextInt(0x80);
+      ForEachSupportedKind([&]() {
+        int start = NonAsciiStart(copy.data(), length);
+        // The scalar loop may stop at the start of the word that contains the
+        // non-ASCII character.
+        EXPECT_LE(start, non_ascii);
+        EXPECT_GT(start + kIntptrSize, non_ascii);
+        if (StringSimd::IsEnabledFor(length)) {
+          EXPECT_EQ(non_ascii, start);
+        }
+      });
+    }
+  }
+}
+
+TEST(StringSimdTest, NonOneByteStart) {
+  base::RandomNumberGenerator rng(42);
+  for (int length : kLengths) {
+    std::vector<base::uc16> chars(length);
+    for (base::uc16& c : chars) c = rng.NextInt(0x100);
+    for (int non_one_byte = 0; non_one_byte <= length; ++non_one_byte) {
+      std::vector<base::uc16> copy = chars;
+      if (non_one_byte < length) {
+        copy[non_one_byte] = 0x100 + rng.NextInt(0xFF00);
+      }
+      ForEachSupportedKind([&]() {
+        EXPECT_EQ(non_one_byte, String::NonOneByteStart(copy.data(), length));
+      });
+    }
+  }
+}
+
+TEST(StringSimdTest, CompareCharsEqualWithSimd) {
+  base::RandomNumberGenerator rng(42);
+  for (int length : kLengths) {
+    std::vector<uint8_t> one_byte(length);
+    for (uint8_t& c : one_byte) c = rng.NextInt(0x100);
+    std::vector<base::uc16> two_byte(one_byte.begin(), one_byte.end());
+    ForEachSupportedKind([&]() {
+      EXPECT_TRUE(
+          CompareCharsEqualWithSimd(one_byte.data(), two_byte.data(), length));
+      EXPECT_TRUE(
+          CompareCharsEqualWithSimd(two_byte.data(), one_byte.data(), length));
+    });
+    for (int i = 0; i < length; ++i) {
+      std::vector<base::uc16> copy = two_byte;
+      // Differ in the low or in the high byte.
+      copy[i] ^= (i % 2 == 0) ? 0x0001 : 0x0100;
+      ForEachSupportedKind([&]() {
+        EXPECT_FALSE(
+            CompareCharsEqualWithSimd(one_byte.data(), copy.data(), length));
+        EXPECT_FALSE(
+            CompareCharsEqualWithSimd(copy.data(), one_byte.data(), length));
+      });
+    }
+  }
+}
+
+TEST(StringSimdTest, NarrowAscii) {
+  base::RandomNumberGenerator rng(42);
+  for (int length : kLengths) {
+    std::vector<uint8_t> text = AsciiChars(&rng, length);
+    std::vector<base::uc16> chars(text.begin(), text.end());
+    for (int non_ascii = 0; non_ascii <= length; ++non_ascii) {
+      std::vector<base::uc16> copy = chars;
+      if (non_ascii < length) copy[non_ascii] = 0x80 + rng.NextInt(0xFF80);
+      ForEachSupportedKind([&]() {
+        std::vector<uint8_t> narrowed(length);
+        EXPECT_EQ(static_cast<size_t>(non_ascii),
+                  StringSimd::NarrowAscii(narrowed.data(), copy.data(),
+                                          length));
+        for (int i = 0; i < non_ascii; ++i) {
+          EXPECT_EQ(text[i], narrowed[i]);
+        }
+      });
+    }
+  }
+}
+
+TEST(StringSimdTest, FastAsciiConvert) {
+  base::RandomNumberGenerator rng(42);
+  for (int length : kLengths) {
+    std::vector<uint8_t> chars = AsciiChars(&rng, length);
+    for (int non_ascii = 0; non_ascii <= length; ++non_ascii) {
+      std::vector<uint8_t> copy = chars;
+      if (non_ascii < length) copy[non_ascii] = 0x80 | rng.NextInt(0x80);
+      const char* src = reinterpret_cast<const char*>(copy.data());
+
+      std::vector<char> expected_lower(length);
+      std::vector<char> expected_upper(length);
+      bool expected_lower_changed = false;
+      bool expected_upper_changed = false;
+      for (int i = 0; i < length; ++i) {
+        char c = src[i];
+        expected_lower[i] = static_cast<char>(ToAsciiLower(c));
+        expected_upper[i] = static_cast<char>(ToAsciiUpper(c));
+        expected_lower_changed |= expected_lower[i] != c;
+        expected_upper_changed |= expected_upper[i] != c;
+      }
+
+      ForEachSupportedKind([&]() {
+        // The destination is a fresh string, which is always word-aligned.
+        std::vector<uintptr_t> storage(length / sizeof(uintptr_t) + 1);
+        char* dst = reinterpret_cast<char*>(storage.data());
+
+        bool changed = false;
+        int converted = FastAsciiConvert<true>(dst, src, length, &changed);
+        // The scalar loop may stop at the start of the word that contains the
+        // non-ASCII character.
+        EXPECT_LE(converted, non_ascii);
+        if (converted == length) {
+          EXPECT_EQ(expected_lower_changed, changed);
+        }
+        for (int i = 0; i < converted; ++i) {
+          EXPECT_EQ(expected_lower[i], dst[i]);
+        }
+
+        changed = false;
+        converted = FastAsciiConvert<false>(dst, src, length, &changed);
+        EXPECT_LE(converted, non_ascii);
+        if (converted == length) {
+          EXPECT_EQ(expected_upper_changed, changed);
+        }
+        for (int i = 0; i < converted; ++i) {
+          EXPECT_EQ(expected_upper[i], dst[i]);
+        }
+      });
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
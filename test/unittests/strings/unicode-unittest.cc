@@ -495,6 +495,27 @@ TEST(UnicodeTest, IncrementalUTF8DecodingVsNonIncrementalUtf8Decoding) {
   }
 }
 
+TEST(UnicodeTest, Utf8DecodingWithAsciiRuns) {
+  // Runs of ASCII characters are decoded in bulk. Put runs of all lengths up
+  // to a few vectors between valid and invalid sequences.
+  const std::vector<uint8_t> kSequences[] = {
+      {0xC3, 0xA9}, {0xE2, 0x80, 0xA6}, {0xF0, 0x9F, 0x98, 0x8D}, {0x80},
+      {0xE2, 0x80}, {0xFF}};
+  for (const std::vector<uint8_t>& sequence : kSequences) {
+    std::vector<uint8_t> bytes;
+    for (int run = 0; run < 100; run++) {
+      bytes.insert(bytes.end(), run, 'a' + run % 26);
+      bytes.insert(bytes.end(), sequence.begin(), sequence.end());
+    }
+
+    std::vector<unibrow::uchar> output_normal;
+    DecodeNormally(bytes, &output_normal);
+    std::vector<unibrow::uchar> output_utf16;
+    DecodeUtf16(bytes, &output_utf16);
+    CHECK(output_normal == output_utf16);
+  }
+}
+
 class UnicodeWithGCTest : public TestWithHeapInternals {};
 
 #define GC_INSIDE_NEW_STRING_FROM_UTF8_SUB_STRING(NAME, STRING)                \
@@ -43,6 +43,44 @@ TEST_F(StructTypesTest, Packing) {
   EXPECT_EQ(9u, type->field_offset(4));
 }
 
+TEST_F(StructTypesTest, PackingMultipleGaps) {
+  // Aligning the first i16 and the i32 leaves two gaps, which are both filled
+  // by the trailing fields.
+  StructType::Builder builder(this->zone(), 6);
+  builder.AddField(kWasmI8, true);
+  builder.AddField(kWasmI16, true);
+  builder.AddField(kWasmI16, true);
+  builder.AddField(kWasmI32, true);
+  builder.AddField(kWasmI8, true);
+  builder.AddField(kWasmI16, true);
+  StructType* type = builder.Build();
+  EXPECT_EQ(RoundUp(12u, kTaggedSize), type->total_fields_size());
+  EXPECT_EQ(0u, type->field_offset(0));
+  EXPECT_EQ(2u, type->field_offset(1));
+  EXPECT_EQ(4u, type->field_offset(2));
+  EXPECT_EQ(8u, type->field_offset(3));
+  EXPECT_EQ(1u, type->field_offset(4));
+  EXPECT_EQ(6u, type->field_offset(5));
+}
+
+TEST_F(StructTypesTest, PackingIsSubtypingSafe) {
+  const ValueType kFields[] = {kWasmI8,  kWasmI64, kWasmI16, kWasmI8,
+                               kWasmI32, kWasmI8,  kWasmI16, kWasmF64};
+  const uint32_t kNumFields = arraysize(kFields);
+  StructType::Builder full_builder(this->zone(), kNumFields);
+  for (ValueType field : kFields) full_builder.AddField(field, true);
+  StructType* full = full_builder.Build();
+  for (uint32_t prefix = 1; prefix < kNumFields; prefix++) {
+    StructType::Builder builder(this->zone(), prefix);
+    for (uint32_t i = 0; i < prefix; i++) builder.AddField(kFields[i], true);
+    StructType* type = builder.Build();
+    for (uint32_t i = 0; i < prefix; i++) {
+      EXPECT_EQ(full->field_offset(i), type->field_offset(i));
+    }
+    EXPECT_LE(type->total_fields_size(), full->total_fields_size());
+  }
+}
+
 TEST_F(StructTypesTest, CopyingOffsets) {
   StructType::Builder builder(this->zone(), 5);
   builder.AddField(kWasmI64, true);